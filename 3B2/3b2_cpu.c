@@ -1362,6 +1362,9 @@ t_stat cpu_set_size(UNIT *uptr, int32 val, CONST char *cptr, void *desc)
     free(RAM);
     RAM = nRAM;
 
+    /* The MMU translation cache holds pointers into the old RAM */
+    mmu_flush_xcache();
+
     MEM_SIZE = uval;
 
     memset(RAM, 0, (size_t)(MEM_SIZE >> 2));
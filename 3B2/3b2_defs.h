@@ -404,6 +404,7 @@ extern void increment_modep_b();
 extern t_stat mmu_decode_va(uint32 va, uint8 r_acc, t_bool fc, uint32 *pa);
 extern void mmu_enable();
 extern void mmu_disable();
+extern void mmu_flush_xcache();
 extern uint8 read_b(uint32 va, uint8 acc);
 extern uint16 read_h(uint32 va, uint8 acc);
 extern uint32 read_w(uint32 va, uint8 acc);
@@ -242,6 +242,14 @@ static SIM_INLINE void flush_cache_sec(uint8 sec)
     }
 }
 
+/*
+ * Invalidate every entry in the translation cache.
+ */
+void mmu_flush_xcache()
+{
+    memset(mmu_state.xc, 0, sizeof(mmu_state.xc));
+}
+
 static SIM_INLINE void flush_caches()
 {
     uint8 i;
@@ -249,6 +257,8 @@ static SIM_INLINE void flush_caches()
     for (i = 0; i < NUM_SEC; i++) {
         flush_cache_sec(i);
     }
+
+    mmu_flush_xcache();
 }
 
 static SIM_INLINE t_stat mmu_check_perm(uint8 flags, uint8 r_acc)
@@ -484,6 +494,8 @@ void mmu_write(uint32 pa, uint32 val, size_t size)
         break;
     case MMU_CONF:
         mmu_state.conf = val & 0x7;
+        /* R and M bit updating may have changed */
+        mmu_flush_xcache();
         break;
     case MMU_VAR:
         mmu_state.var = val;
@@ -1039,6 +1051,133 @@ t_stat read_operand(uint32 va, uint8 *val) {
     return succ;
 }
 
+/*
+ * Look up a virtual address in the translation cache.
+ *
+ * Returns a host pointer to the start of the page on a hit, or NULL
+ * if the full decode must be done.
+ */
+static SIM_INLINE uint32 *mmu_xc_lookup(uint32 va, uint8 r_acc)
+{
+    MMU_XCE *xce;
+    uint8 cm;
+
+    if (!mmu_state.enabled) {
+        return NULL;
+    }
+
+    cm = CPU_CM;
+    xce = &mmu_state.xc[MMU_XC_IDX(va, r_acc, cm)];
+
+    if (xce->key != MMU_XC_KEY(va, r_acc, cm) ||
+        mmu_state.sdcl[xce->sd_ci] != xce->sdcl ||
+        mmu_state.sdch[xce->sd_ci] != xce->sdch) {
+        return NULL;
+    }
+
+    if (xce->pd_side == MMU_XC_LEFT) {
+        if (mmu_state.pdcll[xce->pd_ci] != xce->pdcl ||
+            (mmu_state.pdclh[xce->pd_ci] & ~PDCLH_USED_MASK) != xce->pdch) {
+            return NULL;
+        }
+    } else if (xce->pd_side == MMU_XC_RIGHT) {
+        if (mmu_state.pdcrl[xce->pd_ci] != xce->pdcl ||
+            mmu_state.pdcrh[xce->pd_ci] != xce->pdch) {
+            return NULL;
+        }
+    }
+
+    mmu_state.var = va;
+    return xce->mem;
+}
+
+/*
+ * Fill the translation cache after a successful, fault-checked
+ * decode of "va" to "pa". Nothing is cached if a later access to
+ * the same page could still have a side effect.
+ */
+static void mmu_xc_fill(uint32 va, uint8 r_acc, uint32 pa)
+{
+    MMU_XCE *xce;
+    uint32 sd0, sd1, pd, base, tag;
+    uint32 *mem;
+    uint8 cm, sd_ci, pd_ci, pd_side;
+
+    /* The descriptors used must still be in the caches */
+    if (get_sdce(va, &sd0, &sd1) != SCPE_OK) {
+        return;
+    }
+
+    sd_ci = (SID(va) * NUM_SDCE) + SD_IDX(va);
+    pd_ci = (SID(va) * NUM_PDCE) + PD_IDX(va);
+    pd_side = 0;
+
+    if (SD_PAGED(sd0)) {
+        tag = PD_TAG(va);
+        if ((mmu_state.pdclh[pd_ci] & PD_GOOD_MASK) &&
+            PDCXL_TAG(mmu_state.pdcll[pd_ci]) == tag) {
+            pd_side = MMU_XC_LEFT;
+            pd = PDCXH_TO_PD(mmu_state.pdclh[pd_ci]);
+        } else if ((mmu_state.pdcrh[pd_ci] & PD_GOOD_MASK) &&
+                   PDCXL_TAG(mmu_state.pdcrl[pd_ci]) == tag) {
+            pd_side = MMU_XC_RIGHT;
+            pd = PDCXH_TO_PD(mmu_state.pdcrh[pd_ci]);
+        } else {
+            return;
+        }
+
+        if (SHOULD_UPDATE_PD_R_BIT(pd) || SHOULD_UPDATE_PD_M_BIT(pd)) {
+            return;
+        }
+
+        if (PD_LAST(pd) && (PSL_C(va) | 0x7ff) >= MAX_OFFSET(sd0)) {
+            return;
+        }
+    } else {
+        /* The SD cache does not hold the R bit, so the full decode
+           sets it on every reference. The hardware only sets it when
+           the SD is loaded into the cache, so once cached there is
+           nothing more to do for R. M is held in the cache. */
+        if (SHOULD_UPDATE_SD_M_BIT(sd0) || SD_TRAP(sd0)) {
+            return;
+        }
+
+        if ((SOT(va) | 0x7ff) >= MAX_OFFSET(sd0)) {
+            return;
+        }
+    }
+
+    /* Only pages wholly backed by RAM (or ROM, for reads) are cached */
+    base = pa - POT(va);
+
+    if (addr_is_mem(base) && addr_is_mem(base + 0x7ff)) {
+        mem = RAM + ((base - PHYS_MEM_BASE) >> 2);
+    } else if (r_acc != ACC_W && addr_is_rom(base) && addr_is_rom(base + 0x7ff)) {
+        mem = ROM + (base >> 2);
+    } else {
+        return;
+    }
+
+    cm = CPU_CM;
+    xce = &mmu_state.xc[MMU_XC_IDX(va, r_acc, cm)];
+
+    xce->key = MMU_XC_KEY(va, r_acc, cm);
+    xce->mem = mem;
+    xce->sd_ci = sd_ci;
+    xce->sdcl = mmu_state.sdcl[sd_ci];
+    xce->sdch = mmu_state.sdch[sd_ci];
+    xce->pd_ci = pd_ci;
+    xce->pd_side = pd_side;
+
+    if (pd_side == MMU_XC_LEFT) {
+        xce->pdcl = mmu_state.pdcll[pd_ci];
+        xce->pdch = mmu_state.pdclh[pd_ci] & ~PDCLH_USED_MASK;
+    } else if (pd_side == MMU_XC_RIGHT) {
+        xce->pdcl = mmu_state.pdcrl[pd_ci];
+        xce->pdch = mmu_state.pdcrh[pd_ci];
+    }
+}
+
 uint32 mmu_xlate_addr(uint32 va, uint8 r_acc)
 {
     uint32 pa;
@@ -1048,6 +1187,9 @@ uint32 mmu_xlate_addr(uint32 va, uint8 r_acc)
 
     if (succ == SCPE_OK) {
         mmu_state.var = va;
+        if (mmu_state.enabled) {
+            mmu_xc_fill(va, r_acc, pa);
+        }
         return pa;
     } else {
         cpu_abort(NORMAL_EXCEPTION, EXTERNAL_MEMORY_FAULT);
@@ -1073,35 +1215,84 @@ void mmu_disable()
 
 /*
  * MMU Virtual Read and Write Functions
+ *
+ * Aligned accesses that hit in the translation cache go straight to
+ * memory. Everything else takes the full decode, which also fills
+ * the translation cache.
  */
 
 uint8 read_b(uint32 va, uint8 r_acc)
 {
+    uint32 *m;
+
+    if ((m = mmu_xc_lookup(va, r_acc)) != NULL) {
+        return (m[POT(va) >> 2] >> ((~va & 3) << 3)) & BYTE_MASK;
+    }
+
     return pread_b(mmu_xlate_addr(va, r_acc));
 }
 
 uint16 read_h(uint32 va, uint8 r_acc)
 {
+    uint32 *m;
+
+    if (!(va & 1) && (m = mmu_xc_lookup(va, r_acc)) != NULL) {
+        return (m[POT(va) >> 2] >> ((~va & 2) << 3)) & HALF_MASK;
+    }
+
     return pread_h(mmu_xlate_addr(va, r_acc));
 }
 
 uint32 read_w(uint32 va, uint8 r_acc)
 {
+    uint32 *m;
+
+    if (!(va & 3) && (m = mmu_xc_lookup(va, r_acc)) != NULL) {
+        return m[POT(va) >> 2];
+    }
+
     return pread_w(mmu_xlate_addr(va, r_acc));
 }
 
 void write_b(uint32 va, uint8 val)
 {
+    uint32 *m;
+    int32 sc;
+
+    if ((m = mmu_xc_lookup(va, ACC_W)) != NULL) {
+        sc = (~va & 3) << 3;
+        m += POT(va) >> 2;
+        *m = (*m & ~(0xffu << sc)) | ((uint32) val << sc);
+        return;
+    }
+
     pwrite_b(mmu_xlate_addr(va, ACC_W), val);
 }
 
 void write_h(uint32 va, uint16 val)
 {
+    uint32 *m;
+    int32 sc;
+
+    if (!(va & 1) && (m = mmu_xc_lookup(va, ACC_W)) != NULL) {
+        sc = (~va & 2) << 3;
+        m += POT(va) >> 2;
+        *m = (*m & ~((uint32) HALF_MASK << sc)) | ((uint32) val << sc);
+        return;
+    }
+
     pwrite_h(mmu_xlate_addr(va, ACC_W), val);
 }
 
 void write_w(uint32 va, uint32 val)
 {
+    uint32 *m;
+
+    if (!(va & 3) && (m = mmu_xc_lookup(va, ACC_W)) != NULL) {
+        m[POT(va) >> 2] = val;
+        return;
+    }
+
     pwrite_w(mmu_xlate_addr(va, ACC_W), val);
 }
 
@@ -139,6 +139,22 @@
  *  "U" is only set in the left cache entry, and indicates
  *  which slot (left or right) was most recently updated.
  *
+ *
+ * Translation Cache
+ * -----------------
+ *
+ * This is not part of the WE32101. It is a direct-mapped cache of
+ * host memory pointers, one per 2K virtual page, keyed by the
+ * virtual page, the access type, and the current execution level.
+ * An entry is only filled when a translation has completed with no
+ * side effects left to perform (R and M bits already set, the whole
+ * page within the segment, and the page backed by RAM or ROM).
+ *
+ * Each entry also remembers the SD and PD cache words that produced
+ * it. A hit is only honored if those words are unchanged, so any
+ * change to the SD or PD caches (a fill, a flush, an R/M update, or
+ * a write to the cache registers) falls back to the full decode.
+ *
  ***********************************************************************/
 
 #define MMUBASE 0x40000
@@ -185,6 +201,21 @@
 /* Index of entry in the PD cache */
 #define PD_IDX(vaddr)     (((vaddr >> 11) & 3) | ((vaddr >> 15) & 4))
 
+/* Translation cache */
+#define MMU_XC_SIZE   256   /* Translation cache entries (power of 2) */
+#define MMU_XC_VALID  0x1u
+#define MMU_XC_LEFT   1     /* Entry depends on the left PD cache entry */
+#define MMU_XC_RIGHT  2     /* Entry depends on the right PD cache entry */
+
+/* Translation cache key and index. The page offset bits of the key
+   hold the access type, the execution level, and the valid bit. */
+#define MMU_XC_KEY(va,acc,cm)  (((va) & 0xfffff800u) |                 \
+                                (((uint32)(acc) & 0xf) << 4) |          \
+                                (((uint32)(cm) & 3) << 2) |             \
+                                MMU_XC_VALID)
+#define MMU_XC_IDX(va,acc,cm)  ((((va) >> 11) ^ ((uint32)(acc) << 4) ^  \
+                                 (uint32)(cm)) & (MMU_XC_SIZE - 1))
+
 /* Shift and mask the flag bits for the current CPU mode */
 #define MMU_PERM(f)  ((f >> ((3 - CPU_CM) * 2)) & 3)
 
@@ -289,6 +320,18 @@ typedef struct _mmu_sec {
     uint32 len;
 } mmu_sec;
 
+typedef struct _mmu_xce {
+    uint32  key;            /* Virtual page, access type, level */
+    uint32 *mem;            /* Host pointer to the start of the page */
+    uint8   sd_ci;          /* SD cache index the entry depends on */
+    uint8   pd_ci;          /* PD cache index the entry depends on */
+    uint8   pd_side;        /* PD cache side (0 if contiguous) */
+    uint32  sdcl;           /* Expected SD cache low word */
+    uint32  sdch;           /* Expected SD cache high word */
+    uint32  pdcl;           /* Expected PD cache low word */
+    uint32  pdch;           /* Expected PD cache high word (no U bit) */
+} MMU_XCE;
+
 typedef struct _mmu_state {
     t_bool enabled;         /* Global enabled/disabled flag */
 
@@ -312,6 +355,8 @@ typedef struct _mmu_state {
     uint32 conf;            /* Configuration Register */
     uint32 var;             /* Virtual Address Register */
 
+    MMU_XCE xc[MMU_XC_SIZE]; /* Translation cache (not architectural) */
+
 } MMU_STATE;
 
 extern MMU_STATE mmu_state;
@@ -338,6 +383,7 @@ uint32 safe_read_w(uint32 va);
 
 /* Virtual memory translation */
 uint32 mmu_xlate_addr(uint32 va, uint8 r_acc);
+void   mmu_flush_xcache();
 t_stat mmu_decode_vaddr(uint32 vaddr, uint8 r_acc,
                         t_bool fc, uint32 *pa);
 
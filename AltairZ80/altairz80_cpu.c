@@ -168,6 +168,7 @@ static t_stat cpu_reset(DEVICE *dptr);
 static t_bool cpu_is_pc_a_subroutine_call (t_addr **ret_addrs);
 static t_stat sim_instr_mmu(void);
 static uint32 GetBYTE(register uint32 Addr);
+static uint32 GetWORD(register uint32 Addr);
 static void PutWORD(register uint32 Addr, const register uint32 Value);
 static void PutBYTE(register uint32 Addr, const register uint32 Value);
 static const char* cpu_description(DEVICE *dptr);
@@ -1743,6 +1744,19 @@ static MDEV RAM_PAGE    =   {TRUE,  FALSE,  NULL};  /* this makes a page RAM
 static MDEV EMPTY_PAGE  =   {FALSE, TRUE,   NULL};  /* this is non-existing memory  */
 static MDEV mmu_table[MAXMEMORY >> LOG2PAGESIZE];
 
+/* Fast map of host pointers kept in step with mmu_table. A page which reads
+   (RAM or ROM) or writes (RAM) directly from M has a pointer to its first
+   byte, a NULL entry sends the access through mmu_table to the slow path
+   for memory mapped I/O, missing memory and writes to ROM. */
+static uint8 *mmu_rd[MAXMEMORY >> LOG2PAGESIZE];
+static uint8 *mmu_wr[MAXMEMORY >> LOG2PAGESIZE];
+
+static void mmu_set_page(const uint32 page, const MDEV m) {
+    mmu_table[page] = m;
+    mmu_rd[page] = (m.isRAM || (!m.isEmpty && !m.routine)) ? &M[page << LOG2PAGESIZE] : NULL;
+    mmu_wr[page] = m.isRAM ? &M[page << LOG2PAGESIZE] : NULL;
+}
+
 /* Memory and I/O Resource Mapping and Unmapping routine. */
 uint32 sim_map_resource(uint32 baseaddr, uint32 size, uint32 resource_type,
         int32 (*routine)(const int32, const int32, const int32), uint8 unmap) {
@@ -1760,16 +1774,17 @@ uint32 sim_map_resource(uint32 baseaddr, uint32 size, uint32 resource_type,
                 if (mmu_table[page].routine == routine) {   /* unmap only if it was mapped */
                     if (MEMORYSIZE < MAXBANKSIZE)
                         if (addr < MEMORYSIZE)
-                            mmu_table[page] = RAM_PAGE;
+                            mmu_set_page(page, RAM_PAGE);
                         else
-                            mmu_table[page] = EMPTY_PAGE;
+                            mmu_set_page(page, EMPTY_PAGE);
                     else
-                        mmu_table[page] = RAM_PAGE;
+                        mmu_set_page(page, RAM_PAGE);
                 }
             }
             else {
-                mmu_table[page] = ROM_PAGE;
-                mmu_table[page].routine = routine;
+                MDEV m = ROM_PAGE;
+                m.routine = routine;
+                mmu_set_page(page, m);
             }
         }
     } else if (resource_type == RESOURCE_TYPE_IO) {
@@ -1795,10 +1810,15 @@ uint32 sim_map_resource(uint32 baseaddr, uint32 size, uint32 resource_type,
 
 static void PutBYTE(register uint32 Addr, const register uint32 Value) {
     MDEV m;
+    uint8 *p;
 
     Addr &= ADDRMASK;   /* registers are NOT guaranteed to be always 16-bit values */
     if ((cpu_unit.flags & UNIT_CPU_BANKED) && (Addr < common))
         Addr |= bankSelect << MAXBANKSIZELOG2;
+    if ((p = mmu_wr[Addr >> LOG2PAGESIZE]) != NULL) {
+        p[Addr & (PAGESIZE - 1)] = Value;
+        return;
+    }
     m = mmu_table[Addr >> LOG2PAGESIZE];
 
     if (m.isRAM)
@@ -1815,8 +1835,13 @@ static void PutBYTE(register uint32 Addr, const register uint32 Value) {
 
 void PutBYTEExtended(register uint32 Addr, const register uint32 Value) {
     MDEV m;
+    uint8 *p;
 
     Addr &= ADDRMASKEXTENDED;
+    if ((p = mmu_wr[Addr >> LOG2PAGESIZE]) != NULL) {
+        p[Addr & (PAGESIZE - 1)] = Value;
+        return;
+    }
     m = mmu_table[Addr >> LOG2PAGESIZE];
 
     if (m.isRAM)
@@ -1831,17 +1856,38 @@ void PutBYTEExtended(register uint32 Addr, const register uint32 Value) {
     }
 }
 
+/* A word can be moved through the fast map in one step when both bytes are in
+   the same page and, with banked memory, on the same side of 'common' */
+#define WORD_IN_PAGE(a) ((((a) & (PAGESIZE - 1)) != (PAGESIZE - 1)) &&      \
+    !((cpu_unit.flags & UNIT_CPU_BANKED) && ((a) + 1 == common)))
+
 static void PutWORD(register uint32 Addr, const register uint32 Value) {
+    register uint32 a = Addr & ADDRMASK;
+    uint8 *p;
+
+    if (WORD_IN_PAGE(a)) {
+        if ((cpu_unit.flags & UNIT_CPU_BANKED) && (a < common))
+            a |= bankSelect << MAXBANKSIZELOG2;
+        if ((p = mmu_wr[a >> LOG2PAGESIZE]) != NULL) {
+            p += a & (PAGESIZE - 1);
+            p[0] = Value;
+            p[1] = Value >> 8;
+            return;
+        }
+    }
     PutBYTE(Addr, Value);
     PutBYTE(Addr + 1, Value >> 8);
 }
 
 static uint32 GetBYTE(register uint32 Addr) {
     MDEV m;
+    uint8 *p;
 
     Addr &= ADDRMASK;   /* registers are NOT guaranteed to be always 16-bit values */
     if ((cpu_unit.flags & UNIT_CPU_BANKED) && (Addr < common))
         Addr |= bankSelect << MAXBANKSIZELOG2;
+    if ((p = mmu_rd[Addr >> LOG2PAGESIZE]) != NULL)
+        return p[Addr & (PAGESIZE - 1)];
     m = mmu_table[Addr >> LOG2PAGESIZE];
 
     if (m.isRAM)
@@ -1856,10 +1902,28 @@ static uint32 GetBYTE(register uint32 Addr) {
     return M[Addr]; /* ROM */
 }
 
+static uint32 GetWORD(register uint32 Addr) {
+    register uint32 a = Addr & ADDRMASK;
+    uint8 *p;
+
+    if (WORD_IN_PAGE(a)) {
+        if ((cpu_unit.flags & UNIT_CPU_BANKED) && (a < common))
+            a |= bankSelect << MAXBANKSIZELOG2;
+        if ((p = mmu_rd[a >> LOG2PAGESIZE]) != NULL) {
+            p += a & (PAGESIZE - 1);
+            return p[0] | (p[1] << 8);
+        }
+    }
+    return GetBYTE(Addr) | (GetBYTE(Addr + 1) << 8);
+}
+
 uint32 GetBYTEExtended(register uint32 Addr) {
     MDEV m;
+    uint8 *p;
 
     Addr &= ADDRMASKEXTENDED;
+    if ((p = mmu_rd[Addr >> LOG2PAGESIZE]) != NULL)
+        return p[Addr & (PAGESIZE - 1)];
     m = mmu_table[Addr >> LOG2PAGESIZE];
 
     if (m.isRAM)
@@ -1923,7 +1987,7 @@ void PutByteDMA(const uint32 Addr, const uint32 Value) {
 
 #define RAM_PP(Addr) GetBYTE(Addr++)
 #define RAM_MM(Addr) GetBYTE(Addr--)
-#define GET_WORD(Addr) (GetBYTE(Addr) | (GetBYTE(Addr + 1) << 8))
+#define GET_WORD(Addr) GetWORD(Addr)
 #define PUT_BYTE_PP(a,v) PutBYTE(a++, v)
 #define PUT_BYTE_MM(a,v) PutBYTE(a--, v)
 #define MM_PUT_BYTE(a,v) PutBYTE(--a, v)
@@ -6246,7 +6310,7 @@ t_stat install_bootrom(const int32 bootrom[], const int32 size, const int32 addr
         return SCPE_IERR;
     for (i = 0; i < size; i++) {
         if (makeROM && ((i & (PAGESIZE - 1)) == 0))
-            mmu_table[(i + addr) >> LOG2PAGESIZE] = ROM_PAGE;
+            mmu_set_page((i + addr) >> LOG2PAGESIZE, ROM_PAGE);
         M[i + addr] = bootrom[i] & 0xff;
     }
     return SCPE_OK;
@@ -6436,9 +6500,9 @@ static void cpu_clear(void) {
     for (i = 0; i < MAXMEMORY; i++)
         M[i] = 0;
     for (i = 0; i < (MAXMEMORY >> LOG2PAGESIZE); i++)
-        mmu_table[i] = RAM_PAGE;
+        mmu_set_page(i, RAM_PAGE);
     for (i = (MEMORYSIZE >> LOG2PAGESIZE); i < (MAXMEMORY >> LOG2PAGESIZE); i++)
-        mmu_table[i] = EMPTY_PAGE;
+        mmu_set_page(i, EMPTY_PAGE);
     if (cpu_unit.flags & UNIT_CPU_ALTAIRROM)
         install_ALTAIRbootROM();
     m68k_clear_memory();
@@ -6456,8 +6520,8 @@ static t_stat cpu_set_altairrom(UNIT *uptr, int32 value, CONST char *cptr, void
 }
 
 static t_stat cpu_set_noaltairrom(UNIT *uptr, int32 value, CONST char *cptr, void *desc) {
-    mmu_table[ALTAIR_ROM_LOW >> LOG2PAGESIZE] = MEMORYSIZE < MAXBANKSIZE ?
-        EMPTY_PAGE : RAM_PAGE;
+    mmu_set_page(ALTAIR_ROM_LOW >> LOG2PAGESIZE, MEMORYSIZE < MAXBANKSIZE ?
+        EMPTY_PAGE : RAM_PAGE);
     return SCPE_OK;
 }
 
@@ -6893,12 +6957,12 @@ t_stat sim_load(FILE *fileref, CONST char *cptr, CONST char *fnam, int flag) {
         while ((addr < MAXMEMORY) && ((i = getc(fileref)) != EOF)) {
             m = mmu_table[addr >> LOG2PAGESIZE];
             if (!m.isRAM && m.isEmpty) {
-                mmu_table[addr >> LOG2PAGESIZE] = RAM_PAGE;
+                mmu_set_page(addr >> LOG2PAGESIZE, RAM_PAGE);
                 pagesModified++;
                 m = RAM_PAGE;
             }
             if (makeROM) {
-                mmu_table[addr >> LOG2PAGESIZE] = ROM_PAGE;
+                mmu_set_page(addr >> LOG2PAGESIZE, ROM_PAGE);
                 m = ROM_PAGE;
             }
             if (!m.isRAM && m.routine)
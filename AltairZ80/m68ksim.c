@@ -116,6 +116,10 @@
 #define M68K_GET_TIME   (0xff7ff8)  // read long to get time in seconds
 #define M68K_STOP_CPU   (0xff7ffc)  // write long to stop CPU and return to SIMH prompt
 
+/* All memory mapped I/O lives in the 64KB page at DISK_BASE. Accesses below it
+   go straight to RAM, only that page takes the device and bounds checks. */
+#define M68K_IO_BASE    DISK_BASE
+
 /* IRQ connections */
 #define IRQ_NMI_DEVICE  7
 #define IRQ_MC6850      5
@@ -349,6 +353,8 @@ unsigned int m68k_cpu_read_byte_raw(unsigned int address) {
 }
 
 unsigned int m68k_cpu_read_byte(unsigned int address) {
+    if (address < M68K_IO_BASE - 3)
+        return READ_BYTE(m68k_ram, address);
     switch(address) {
         case MC6850_DATA:
             return MC6850_data_read();
@@ -367,6 +373,8 @@ unsigned int m68k_cpu_read_byte(unsigned int address) {
 }
 
 unsigned int m68k_cpu_read_word(unsigned int address) {
+    if (address < M68K_IO_BASE - 3)
+        return READ_WORD(m68k_ram, address);
     switch(address) {
         case DISK_STATUS:
             return hdsk_getStatus();
@@ -383,6 +391,8 @@ unsigned int m68k_cpu_read_word(unsigned int address) {
 }
 
 unsigned int m68k_cpu_read_long(unsigned int address) {
+    if (address < M68K_IO_BASE - 3)
+        return READ_LONG(m68k_ram, address);
     switch(address) {
         case DISK_STATUS:
             return hdsk_getStatus();
@@ -413,6 +423,10 @@ void m68k_cpu_write_byte_raw(unsigned int address, unsigned int value) {
 }
 
 void m68k_cpu_write_byte(unsigned int address, unsigned int value) {
+    if (address < M68K_IO_BASE - 3) {
+        WRITE_BYTE(m68k_ram, address, value);
+        return;
+    }
     switch(address) {
         case MC6850_DATA:
             MC6850_data_write(value & 0xff);
@@ -433,6 +447,10 @@ void m68k_cpu_write_byte(unsigned int address, unsigned int value) {
 }
 
 void m68k_cpu_write_word(unsigned int address, unsigned int value) {
+    if (address < M68K_IO_BASE - 3) {
+        WRITE_WORD(m68k_ram, address, value);
+        return;
+    }
     if (address > M68K_MAX_RAM-1) {
         if (cpu_unit.flags & UNIT_CPU_VERBOSE)
             sim_printf("M68K: 0x%08x Attempt to write word 0x%04x to non existing memory 0x%08x." NLP,
@@ -443,6 +461,10 @@ void m68k_cpu_write_word(unsigned int address, unsigned int value) {
 }
 
 void m68k_cpu_write_long(unsigned int address, unsigned int value) {
+    if (address < M68K_IO_BASE - 3) {
+        WRITE_LONG(m68k_ram, address, value);
+        return;
+    }
     switch(address) {
         case DISK_SET_DRIVE:
             hdsk_setSelectedDisk(value);
@@ -136,6 +136,13 @@
 #define HIST_MIN        64
 #define HIST_MAX        65536
 
+#define D8_LNT          8                               /* digits per step */
+#define D8_ONES         ((t_uint64) 0x0101010101010101LL) /* 1 per digit */
+#define D8_HIGH         (D8_ONES * 0xF0)                /* flag, junk bits */
+#define D8_SIX          (D8_ONES * 0x06)                /* 6 per digit */
+#define D8_NINE         (D8_ONES * 0x09)                /* 9 per digit */
+#define D8_BIAS         (D8_ONES * 0xF6)                /* 256 - 10 */
+
 typedef struct {
     uint16              vld;
     uint16              pc;
@@ -195,6 +202,7 @@ t_stat xmt_tnf (uint32 d, uint32 s);
 t_stat add_field (uint32 d, uint32 s, t_bool sub, uint32 skp, int32 *sta);
 t_stat cmp_field (uint32 d, uint32 s);
 uint32 add_one_digit (uint32 dst, uint32 src, uint32 *cry);
+t_bool add_8_digits (uint32 d, uint32 s, t_bool comp, t_bool sto, uint32 *cry);
 t_stat mul_field (uint32 mpc, uint32 mpy);
 t_stat mul_one_digit (uint32 mpyd, uint32 mpcp, uint32 prop, uint32 last);
 t_stat div_field (uint32 dvd, uint32 dvr, int32 *ez);
@@ -1440,6 +1448,14 @@ res = add_one_digit (dst, src, &cry);                   /* add */
 M[d] = (M[d] & FLAG) | res;                             /* store */
 MM (d); MM (s);                                         /* decr mem addrs */
 do {
+    if (!src_f && (cnt >= skp) &&                       /* 8 digits at once? */
+        add_8_digits (d, s, comp, TRUE, &cry)) {
+        d = d - D8_LNT;                                 /* advance addrs */
+        s = s - D8_LNT;
+        cnt = cnt + D8_LNT;
+        dst_f = 0;                                      /* no flags seen */
+        continue;
+        }
     dst = M[d] & DIGIT;                                 /* get dst digit */
     dst_f = M[d] & FLAG;                                /* get dst flag */
     if (src_f)                                          /* src done? src = 0 */
@@ -1516,6 +1532,13 @@ ind[IN_HP] = ((M[d] & FLAG) == 0);                      /* set sign from res */
 ind[IN_EZ] = 1;                                         /* assume zero */
 
 do {
+    if (!unlike && !src_f && (d != dsv) &&              /* 8 digits at once? */
+        add_8_digits (d, s, TRUE, FALSE, &cry)) {
+        d = d - D8_LNT;                                 /* advance addrs */
+        s = s - D8_LNT;
+        cnt = cnt + D8_LNT;
+        continue;
+        }
     dst = M[d] & DIGIT;                                 /* get dst digit */
     if (d != dsv)                                       /* if not first digit, */
         dst_f = M[d] & FLAG;                            /* get dst flag */
@@ -1585,6 +1608,59 @@ if (res & DIGIT)                                        /* nz? clr ind */
 return res & DIGIT;
 }
 
+/* Add eight digits at once (Model 2)
+
+   Inputs:
+        d       =       low order dst digit address
+        s       =       low order src digit address
+        comp    =       TRUE if src is to be 9s complemented
+        sto     =       TRUE if the sum is stored at d
+        cry     =       pointer to carry in/out
+   Output:
+        return  =       TRUE if done, FALSE if the caller must go digit
+                        by digit (Model 1 table add, flag or invalid digit
+                        in either group, memory wrap, or overlapping fields)
+
+   The digits are packed one per byte, low order digit in the low order byte.
+   Each src digit is biased by 256 - 10, so a binary add of the two words
+   carries out of a byte exactly when the decimal digit pair does; bytes
+   that did not carry are then unbiased.
+*/
+
+t_bool add_8_digits (uint32 d, uint32 s, t_bool comp, t_bool sto, uint32 *cry)
+{
+t_uint64 dw, sw, res, nc;
+uint32 i;
+
+if (((cpu_unit.flags & IF_MII) == 0) ||                 /* Model 1 table add? */
+    (d < (D8_LNT - 1)) || (s < (D8_LNT - 1)) ||         /* would wrap? */
+    ((s > d) && ((s - d) < D8_LNT)))                    /* src overwritten? */
+    return FALSE;
+for (i = 0, dw = sw = 0; i < D8_LNT; i++) {            /* get digits, */
+    dw = (dw << 8) | M[d - (D8_LNT - 1) + i];           /* high order first */
+    sw = (sw << 8) | M[s - (D8_LNT - 1) + i];
+    }
+if ((dw | sw) & D8_HIGH)                                /* any flags? */
+    return FALSE;
+if (((dw + D8_SIX) | (sw + D8_SIX)) & D8_HIGH)          /* any digit > 9? */
+    return FALSE;
+if (comp)                                               /* complement? */
+    sw = D8_NINE - sw;
+res = dw + (sw + D8_BIAS) + (*cry? 1: 0);               /* add */
+nc = (res >> 7) & D8_ONES;                              /* bytes w/o carry */
+res = res - (nc * 0xF6);                                /* unbias them */
+*cry = (uint32) ((nc >> ((D8_LNT - 1) * 8)) ^ 1);       /* carry out */
+if (res != 0)                                           /* nz? clr ind */
+    ind[IN_EZ] = 0;
+if (sto) {                                              /* store sum? */
+    for (i = 0; i < D8_LNT; i++) {
+        M[d - i] = (uint8) (res & DIGIT);
+        res = res >> 8;
+        }
+    }
+return TRUE;
+}
+
 /* Multiply routine 
 
    Inputs:
@@ -32,6 +32,7 @@ extern DEVICE      *sim_devices[];
 
 
 int     num_devs[NUM_CHAN];
+uint32  chan_pend;              /* Channels whose state changed since chan_proc */
 
 
 t_stat
@@ -422,6 +423,7 @@ int chan_error(int chan)
 int chan_stat(int chan, uint32 flag)
 {
     if (chan_flags[chan] & flag) {
+        CHAN_PEND(chan);
         chan_flags[chan] &= ~flag;
         return 1;
     }
@@ -452,24 +454,28 @@ int chan_active(int chan)
 void
 chan_set_attn(int chan)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] |= CHS_ATTN;
 }
 
 void
 chan_set_eof(int chan)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] |= CHS_EOF;
 }
 
 void
 chan_set_error(int chan)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] |= CHS_ERR;
 }
 
 void
 chan_set_sel(int chan, int need)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] &=
         ~(DEV_WEOR | DEV_REOR | DEV_FULL | DEV_WRITE | DEV_DISCO);
     chan_flags[chan] |= DEV_SEL;
@@ -480,6 +486,7 @@ chan_set_sel(int chan, int need)
 void
 chan_clear_status(int chan)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] &=
         ~(CHS_ATTN | CHS_EOT | CHS_BOT | DEV_REOR | DEV_WEOR);
 }
@@ -487,17 +494,20 @@ chan_clear_status(int chan)
 void
 chan_set(int chan, uint32 flag)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] |= flag;
 }
 
 void
 chan_clear(int chan, uint32 flag)
 {
+    CHAN_PEND(chan);
     chan_flags[chan] &= ~flag;
 }
 
 void
 chan9_clear_error(int chan, int sel) {
+    CHAN_PEND(chan);
     chan_flags[chan] &= ~(SNS_UEND | (SNS_ATTN1 >> sel));
 }
 
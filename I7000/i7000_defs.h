@@ -273,6 +273,9 @@ extern DEBTAB crd_debug[];
 /* Channel half of controls */
 /* Channel status */
 extern uint32   chan_flags[NUM_CHAN];           /* Channel flags */
+extern uint32   chan_pend;                      /* Channels chan_proc must look at */
+#define CHAN_PEND(chan) (chan_pend |= (1 << (chan)))
+#define CHAN_PEND_ALL   ((1 << NUM_CHAN) - 1)
 extern const char *chname[11];                  /* Channel names */
 extern int      num_devs[NUM_CHAN];             /* Number devices per channel*/
 extern uint8    lpr_chan9[NUM_CHAN];
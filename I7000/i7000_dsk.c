@@ -526,6 +526,7 @@ t_stat dsk_srv(UNIT * uptr)
             sense_unit[schan] |= 1 << unit_bit[dev];
 #ifdef I7010
             chan_seek_done[chan] = 1;
+            CHAN_PEND(chan);
 #else
             chan9_set_attn(chan, sel);
 #endif
@@ -206,6 +206,7 @@ chan_reset(DEVICE * dptr)
         cmd[i] = 0;
         bcnt[i] = 0;
     }
+    chan_pend = CHAN_PEND_ALL;
     return chan_set_devs(dptr);
 }
 
@@ -229,6 +230,7 @@ chan_boot(int32 unit_num, DEVICE * dptr)
     cmd[chan] = CHAN_NOREC|CHAN_LOAD;
     chunit[chan] = unit_num;
     chan_flags[chan] |= STA_ACTIVE;
+    CHAN_PEND(chan);
     return SCPE_OK;
 }
 
@@ -286,18 +288,30 @@ chan_proc()
 {
     int                 chan;
     int                 cmask;
+    uint32              flags;
+    uint32              addr;
+    uint8               op;
+
+    /* Nothing to do unless some channel has had its state changed */
+    if (chan_pend == 0)
+        return;
 
     /* Scan channels looking for work */
     for (chan = 0; chan < NUM_CHAN; chan++) {
+        if ((chan_pend & (1 << chan)) == 0)
+            continue;
+        flags = chan_flags[chan];
+        addr = caddr[chan];
+        op = cmd[chan];
 
         /* Skip if channel is disabled */
         if (chan_unit[chan].flags & UNIT_DIS)
-            continue;
+            goto next;
 
         cmask = 0x0100 << chan;
        /* If channel is disconnecting, do nothing */
         if (chan_flags[chan] & DEV_DISCO)
-             continue;
+             goto next;
 
         if (chan_flags[chan] & CHS_EOF) {
              chan_io_status[chan] |= IO_CHS_COND;
@@ -343,7 +357,7 @@ chan_proc()
                         chan_flags[chan] &= ~(STA_ACTIVE|SNS_UEND|CTL_END);
                     chan_io_status[chan] |= IO_CHS_DONE;
                 }
-                continue;
+                goto next;
             }
         }
 
@@ -354,7 +368,7 @@ chan_proc()
                 chan_flags[chan] &= ~(STA_ACTIVE|SNS_UEND);
                 cmd[chan] &= ~CHAN_DSK_SEEK;
             }
-            continue;
+            goto next;
         }
 
         if ((chan_flags[chan] & (CTL_READ|CTL_WRITE)) &&
@@ -407,7 +421,7 @@ chan_proc()
              if (chan_dev.dctrl & cmask)
                 sim_debug(DEBUG_EXP, &chan_dev, "chan %d EOR %d %o\n", chan,
                        caddr[chan], chan_io_status[chan]);
-             continue;
+             goto next;
         }
 
         if (((chan_flags[chan] & (DEV_SEL|STA_ACTIVE)) == STA_ACTIVE) &&
@@ -426,8 +440,14 @@ chan_proc()
              if (chan_dev.dctrl & cmask)
                     sim_debug(DEBUG_EXP, &chan_dev, "chan %d Attn %o\n",
                               chan, chan_io_status[chan]);
-             continue;
+             goto next;
         }
+        next:
+        /* If nothing moved, channel is waiting on a device, and stays */
+        /* idle until the device changes its state again. */
+        if (flags == chan_flags[chan] && addr == caddr[chan] &&
+            op == cmd[chan])
+            chan_pend &= ~(1 << chan);
     }
 }
 
@@ -460,6 +480,7 @@ chan_cmd(uint16 dev, uint16 dcmd, uint32 addr)
     /* Unit is busy doing something, wait */
     if (chan_flags[chan] & (DEV_SEL|DEV_DISCO|STA_TWAIT|STA_WAIT|STA_ACTIVE))
         return SCPE_BUSY;
+    CHAN_PEND(chan);
     /* Ok, try and find the unit */
     caddr[chan] = addr;
     assembly[chan] = 0;
@@ -560,6 +581,7 @@ chan_write_char(int chan, uint8 * data, int flags)
 {
     uint8       ch = *data;
 
+    CHAN_PEND(chan);
     sim_debug(DEBUG_DATA, &chan_dev, "chan %d char %o %d %o %o\n", chan,
                *data, caddr[chan], chan_io_status[chan], flags);
 
@@ -629,6 +651,7 @@ chan_write_char(int chan, uint8 * data, int flags)
 int
 chan_read_char(int chan, uint8 * data, int flags)
 {
+    CHAN_PEND(chan);
 
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
@@ -701,6 +724,7 @@ chan_read_char(int chan, uint8 * data, int flags)
 void
 chan9_set_error(int chan, uint32 mask)
 {
+    CHAN_PEND(chan);
     if (chan_flags[chan] & mask)
         return;
     chan_flags[chan] |= mask;
@@ -582,6 +582,7 @@ sim_instr(void)
 
     reason = 0;
     fault = 0;
+    chan_pend = CHAN_PEND_ALL;          /* Registers may have been changed */
     if (cpu_unit.flags & OPTION_PROT)
         sim_activate(&cpu_unit, sim_rtcn_calb(cpu_unit.wait, TMR_RTC));
 
@@ -252,6 +252,7 @@ chan_reset(DEVICE * dptr)
         location[i] = 0;
         counter[i] = 0;
     }
+    chan_pend = CHAN_PEND_ALL;
     return chan_set_devs(dptr);
 }
 
@@ -275,6 +276,7 @@ chan_boot(int32 unit_num, DEVICE * dptr)
     }
     chan_flags[chan] |= STA_ACTIVE;
     chan_flags[chan] &= ~STA_PEND;
+    CHAN_PEND(chan);
     return SCPE_OK;
 }
 
@@ -330,16 +332,35 @@ chan_proc()
 {
     int                 chan;
     int                 cmask;
+    uint32              flags;
+    uint16              info;
+    uint16              loc;
+    uint16              addr;
+    uint16              wc;
+    uint8               op;
+
+    /* Nothing to do unless some channel has had its state changed */
+    if (chan_pend == 0)
+        return;
 
     /* Scan channels looking for work */
     for (chan = 0; chan < NUM_CHAN; chan++) {
+        if ((chan_pend & (1 << chan)) == 0)
+            continue;
+        flags = chan_flags[chan];
+        info = chan_info[chan];
+        loc = location[chan];
+        addr = caddr[chan];
+        wc = wcount[chan];
+        op = cmd[chan];
+
         /* Skip if channel is disabled */
         if (chan_unit[chan].flags & UNIT_DIS)
-            continue;
+            goto next;
 
         /* If channel is disconnecting, do nothing */
         if (chan_flags[chan] & DEV_DISCO)
-            continue;
+            goto next;
 
         cmask = 0x0100 << chan;
         switch (CHAN_G_TYPE(chan_unit[chan].flags)) {
@@ -362,10 +383,10 @@ chan_proc()
                     sim_debug(DEBUG_DETAIL, &chan_dev, "chan %d HDaddr %012llo\n",
                               chan, hsdrm_addr);
                 chan_fetch(chan);
-                continue;
+                goto next;
             }
             if ((chan_info[chan] & CHAINF_START) == 0)
-                continue;
+                goto next;
             /* Fall through and behave like 7607 from now on */
         case CHAN_7607:
             /* If no select, stop channel */
@@ -378,7 +399,7 @@ chan_proc()
                 chan_flags[chan] &=
                     ~(STA_START | STA_ACTIVE | STA_WAIT | STA_TWAIT);
                 chan_info[chan] = 0;
-                continue;
+                goto next;
             }
 
             /* If device requested attention, abort current command */
@@ -398,7 +419,7 @@ chan_proc()
                 if (chan_dev.dctrl & cmask)
                      sim_debug(DEBUG_DETAIL, &chan_dev,
                         "chan %d attn< %o\n", chan, cmd[chan] & 070);
-                continue;
+                goto next;
             }
 
             /* If we are waiting and get EOR, then continue along */
@@ -412,7 +433,7 @@ chan_proc()
 
             /* All done if waiting for EOR */
             if (chan_flags[chan] & STA_WAIT)
-                continue;
+                goto next;
 
             /* No activity, nothing happening here folks, move along */
             if ((chan_flags[chan] & (STA_ACTIVE | STA_WAIT)) == 0) {
@@ -420,7 +441,7 @@ chan_proc()
                 if ((chan_flags[chan] & (STA_TWAIT|STA_PEND|DEV_SEL))
                          == (STA_TWAIT|DEV_SEL))
                     chan_flags[chan] |= DEV_DISCO|DEV_WEOR;
-                continue;
+                goto next;
             }
 
             /* If command is a transfer, Do transfer */
@@ -429,7 +450,7 @@ chan_proc()
                 chan_fetch(chan);
                 /* Give up bus if next command is a tranfer. */
                 if ((cmd[chan] & 070) == TCH)
-                    continue;
+                    goto next;
             }
 
             /* None disabled, active channel is if transfering */
@@ -469,7 +490,7 @@ chan_proc()
                                   chan, cmd[chan] & 070);
                         chan_fetch(chan);
                         chan_flags[chan] |= STA_ACTIVE;
-                        continue;       /* Handle new command next time */
+                        goto next;      /* Handle new command next time */
                     case IORT:
                     case IOST:
                         chan_flags[chan] &= ~(DEV_REOR|DEV_WEOR);
@@ -479,7 +500,7 @@ chan_proc()
                             sim_debug(DEBUG_DETAIL, &chan_dev,
                                         "chan %d EOR< %o\n",
                                         chan, cmd[chan] & 070);
-                        continue;
+                        goto next;
                     }
                 }
 
@@ -534,7 +555,7 @@ chan_proc()
                         if (chan_dev.dctrl & cmask)
                             sim_debug(DEBUG_DETAIL, &chan_dev,
                                 "chan %d -Sel< %o\n", chan, cmd[chan] & 070);
-                        continue;       /* Handle new command next time */
+                        goto next;      /* Handle new command next time */
                     case IOCT:
                     case IORT:
                     case IOST:  /* Behave like EOR */
@@ -543,7 +564,7 @@ chan_proc()
                         if (chan_dev.dctrl & cmask)
                             sim_debug(DEBUG_DETAIL, &chan_dev,
                                 "chan %d -Sel< %o\n", chan, cmd[chan] & 070);
-                        continue;
+                        goto next;
                     }
                 }
 
@@ -561,7 +582,7 @@ chan_proc()
                         chan_flags[chan] &= ~DEV_FULL;
                     }
                 }
-                continue;       /* Do nothing if no data xfer pending */
+                goto next;      /* Do nothing if no data xfer pending */
 
                 /* Device needs a word of data */
             case DEV_WRITE:     /* Device needs data word */
@@ -575,13 +596,13 @@ chan_proc()
                         if (chan_dev.dctrl & cmask)
                             sim_debug(DEBUG_DETAIL, &chan_dev,
                                 "chan %d -Sel< %o\n", chan, cmd[chan] & 070);
-                        continue;       /* Handle new command next time */
+                        goto next;      /* Handle new command next time */
                     case IOCD:
                         chan_flags[chan] &= ~(STA_START|STA_ACTIVE);
                         if (chan_dev.dctrl & cmask)
                             sim_debug(DEBUG_DETAIL, &chan_dev,
                                 "chan %d -Sel< %o\n", chan, cmd[chan] & 070);
-                        continue;
+                        goto next;
                     case IOCT:
                     case IORT:
                     case IOST:
@@ -590,13 +611,13 @@ chan_proc()
                         if (chan_dev.dctrl & cmask)
                             sim_debug(DEBUG_DETAIL, &chan_dev,
                                 "chan %d -Sel< %o\n", chan, cmd[chan] & 070);
-                        continue;
+                        goto next;
                     }
                 }
 
                 /* Wait for device to recognize EOR */
                 if (chan_flags[chan] & DEV_WEOR)
-                    continue;
+                    goto next;
 
                     /* Check if got EOR */
                     if (chan_flags[chan] & DEV_REOR) {
@@ -615,7 +636,7 @@ chan_proc()
                             if (chan_dev.dctrl & cmask)
                                 sim_debug(DEBUG_DETAIL, &chan_dev,
                                     "chan %d EOR> %o\n", chan, cmd[chan] & 070);
-                            continue;
+                            goto next;
                         }
                     }
 
@@ -638,7 +659,7 @@ chan_proc()
                     bcnt[chan] = 6;
                     wcount[chan]--;
                     chan_flags[chan] |= DEV_FULL;
-                    continue;   /* Don't start next command until data taken */
+                    goto next;  /* Don't start next command until data taken */
                 }
 
                 /* Get here if wcount == 0 */
@@ -694,7 +715,7 @@ chan_proc()
                         sim_debug(DEBUG_DETAIL, &chan_dev,
                             "chan %d EOR Continue\n", chan);
                 }
-                continue;
+                goto next;
             }
 
             /* Nothing more to do if not active. */
@@ -739,7 +760,7 @@ chan_proc()
                     nxt_chan_addr(chan);
                     bcnt[chan] = 6;
                     location[chan]++;
-                    continue;
+                    goto next;
                 case LIPT:
                 case LIPTX:
                     chan_flags[chan] &= ~(SNS_IRQ | SNS_IMSK | SNS_UEND);
@@ -764,7 +785,7 @@ chan_proc()
                         goto xfer;
                     if (chan_flags[chan] & (CTL_READ | CTL_WRITE | CTL_SNS)) {
                         chan9_seqcheck(chan);
-                        continue;
+                        goto next;
                     }
                     chan_flags[chan] |= CTL_CNTL;
                     goto finddev;
@@ -841,9 +862,9 @@ chan_proc()
                             iotraps |= 1 << chan;
                             chan_flags[chan] &= ~(CTL_PREAD|CTL_PWRITE|CTL_SNS|
                                  CTL_CNTL|STA_ACTIVE);
-                            continue;
+                            goto next;
                         case SCPE_BUSY: /* Device not ready yet, wait */
-                            continue;
+                            goto next;
                         case SCPE_OK:   /* Device will be waiting for command */
                             break;
                         }
@@ -887,7 +908,7 @@ chan_proc()
                         bcnt[chan] = 6;
                         chan_flags[chan] |= DEV_FULL;
                     }
-                    continue;
+                    goto next;
 
                 case LAR:
                     if (chan_flags[chan] & DEV_SEL) {
@@ -997,7 +1018,7 @@ chan_proc()
                             /* Get new command ready after disco */
                             chan_fetch(chan);
                         }
-                        continue;       /* Do nothing if no data xfer */
+                        goto next;      /* Do nothing if no data xfer */
                     case DEV_WRITE:     /* Device needs data word */
                         assembly[chan] = M[caddr[chan]];
                         if (chan_dev.dctrl & cmask)
@@ -1041,7 +1062,7 @@ chan_proc()
                         break;
                     }
 
-                    continue;
+                    goto next;
 
                 case TCM:
                 case TCMX:
@@ -1176,6 +1197,13 @@ chan_proc()
             }
 #endif
         }
+        next:
+        /* If nothing moved, channel is waiting on a device or the CPU, */
+        /* and stays idle until one of them changes its state again. */
+        if (flags == chan_flags[chan] && info == chan_info[chan] &&
+            loc == location[chan] && addr == caddr[chan] &&
+            wc == wcount[chan] && op == cmd[chan] && chan_irq[chan] == 0)
+            chan_pend &= ~(1 << chan);
     }
 }
 
@@ -1190,6 +1218,7 @@ chan_fetch(int chan)
     if (dualcore)
         loc |= location[chan] & 0100000;
     temp = M[loc];
+    CHAN_PEND(chan);
     location[chan] = ((loc + 1) & MEMMASK) | (loc & 0100000);
     cmd[chan] = (uint8)(((temp >> 30) & 074) | ((temp >> 16) & 1));
     wcount[chan] = (uint16)(temp >> 18) & 077777;
@@ -1224,6 +1253,7 @@ chan_rst(int chan, int type)
         return;
     if (chan_dev.dctrl & (0x0100 << chan))
         sim_debug(DEBUG_CHAN, &chan_dev, "Reset channel\n");
+    CHAN_PEND(chan);
     /* Clear outstanding traps on reset */
     if (type)
         iotraps &= ~(1 << chan);
@@ -1253,6 +1283,7 @@ chan_cmd(uint16 dev, uint16 dcmd)
     /* If no channel device, quick exit */
     if (chan_unit[chan].flags & UNIT_DIS)
         return SCPE_IOERR;
+    CHAN_PEND(chan);
     /* On 704 device new command aborts current operation */
     if (CHAN_G_TYPE(chan_unit[chan].flags) == CHAN_PIO &&
         (chan_flags[chan] & (DEV_SEL | DEV_DISCO)) == DEV_SEL) {
@@ -1320,6 +1351,7 @@ chan_start(int chan, uint16 addr)
     /* Hold this command until after channel has disconnected */
     if (chan_flags[chan] & DEV_DISCO)
         return SCPE_BUSY;
+    CHAN_PEND(chan);
 
     /* Depending on channel type controls how command works */
     if (CHAN_G_TYPE(chan_unit[chan].flags) == CHAN_7909) {
@@ -1354,6 +1386,7 @@ chan_start(int chan, uint16 addr)
 int
 chan_load(int chan, uint16 addr)
 {
+    CHAN_PEND(chan);
     if (CHAN_G_TYPE(chan_unit[chan].flags) == CHAN_7909) {
         if (chan_flags[chan] & STA_ACTIVE)
             return SCPE_BUSY;
@@ -1444,6 +1477,7 @@ chan_store_diag(int chan, uint16 loc)
 int
 chan_write(int chan, t_uint64 * data, int flags)
 {
+    CHAN_PEND(chan);
 
     /* Check if last data still not taken */
     if (chan_flags[chan] & DEV_FULL) {
@@ -1487,6 +1521,7 @@ chan_write(int chan, t_uint64 * data, int flags)
 int
 chan_read(int chan, t_uint64 * data, int flags)
 {
+    CHAN_PEND(chan);
 
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
@@ -1536,6 +1571,7 @@ chan_read(int chan, t_uint64 * data, int flags)
 int
 chan_write_char(int chan, uint8 * data, int flags)
 {
+    CHAN_PEND(chan);
     /* If Writing end of record, abort */
     if (chan_flags[chan] & DEV_WEOR) {
         chan_flags[chan] &= ~(DEV_FULL | DEV_WEOR);
@@ -1598,6 +1634,7 @@ chan_write_char(int chan, uint8 * data, int flags)
 int
 chan_read_char(int chan, uint8 * data, int flags)
 {
+    CHAN_PEND(chan);
 
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
@@ -1665,6 +1702,7 @@ chan9_seqcheck(int chan)
 void
 chan9_set_error(int chan, uint32 mask)
 {
+    CHAN_PEND(chan);
     if (chan_flags[chan] & mask)
         return;
     chan_flags[chan] |= mask;
@@ -747,6 +747,7 @@ sim_instr(void)
 
     reason = 0;
     hltinst = 0;
+    chan_pend = CHAN_PEND_ALL;          /* Registers may have been changed */
 
     /* Enable timer if option set */
     if (cpu_unit.flags & OPTION_TIMER) {
@@ -164,9 +164,29 @@
 #define VAMASK          VAMASK32
 #define NRSETS          8                               /* up to 8 reg sets */
 #define PSW_MASK        PSW_x32
-#define ABORT(val)      longjmp (save_env, (val))
 #define MPRO            (-1)
 
+/* Memory management aborts
+
+   By default, a memory protection abort in Reloc executes a longjmp
+   back to sim_instr.  If ID32_NO_SETJMP is defined at build time, Reloc
+   instead records the abort in mem_abort and returns.  Once an abort is
+   pending, further relocations are suppressed, memory writes are
+   discarded, and the instruction flow tests MEM_ABORT after each
+   reference that precedes a change to processor state.  sim_instr then
+   needs no setjmp, and its locals need not be volatile.
+*/
+
+#if defined (ID32_NO_SETJMP)
+#define ABORT(val)      mem_abort = (val)
+#define MEM_ABORT       (mem_abort != 0)
+#define FP_ABORT(o,e)   fp_probe (o, e)
+#else
+#define ABORT(val)      longjmp (save_env, (val))
+#define MEM_ABORT       0
+#define FP_ABORT(o,e)   0
+#endif
+
 #define UNIT_V_MSIZE    (UNIT_V_UF + 0)                 /* dummy mask */
 #define UNIT_V_DPFP     (UNIT_V_UF + 1)
 #define UNIT_V_832      (UNIT_V_UF + 2)
@@ -250,7 +270,11 @@ uint32 hst_p = 0;                                       /* history pointer */
 uint32 hst_lnt = 0;                                     /* history length */
 uint32 psw_reg_mask = 1;                                /* PSW reg mask */
 InstHistory *hst = NULL;                                /* instruction history */
+#if defined (ID32_NO_SETJMP)
+int32 mem_abort = 0;                                    /* abort pending */
+#else
 jmp_buf save_env;                                       /* abort handler */
+#endif
 struct BlockIO blk_io;                                  /* block I/O status */
 uint32 (*dev_tab[DEVNO])(uint32 dev, uint32 op, uint32 datout) = { NULL };
 
@@ -264,6 +288,9 @@ uint32 addtoq (uint32 ea, uint32 val, uint32 flg);
 uint32 remfmq (uint32 ea, uint32 r1, uint32 flg);
 uint32 exception (uint32 loc, uint32 cc, uint32 flg);
 uint32 newPSW (uint32 val);
+#if defined (ID32_NO_SETJMP)
+t_bool fp_probe (uint32 op, uint32 ea);
+#endif
 uint32 testsysq (uint32 cc);
 uint32 display (uint32 dev, uint32 op, uint32 dat);
 t_stat cpu_ex (t_value *vptr, t_addr addr, UNIT *uptr, int32 sw);
@@ -607,9 +634,14 @@ DEVICE cpu_dev = {
 
 t_stat sim_instr (void)
 {
+#if defined (ID32_NO_SETJMP)
+uint32 cc;
+t_stat reason;
+#else
 volatile uint32 cc;                                     /* set before setjmp */
 t_stat reason;                                          /* set after setjmp */
 int abortval;
+#endif
 
 /* Restore register state */
 
@@ -638,14 +670,20 @@ reason = 0;
    Interdata 32b systems.  All referenced variables must be globals,
    and all sim_instr scoped automatic variables must be volatile or
    set after the call on setjmp.
+
+   If ID32_NO_SETJMP is defined, the abort is instead noted in mem_abort,
+   the instruction is abandoned, and the abort is processed at the top
+   of the loop.
 */
 
+#if !defined (ID32_NO_SETJMP)
 abortval = setjmp (save_env);                           /* set abort hdlr */
 if (abortval != 0) {                                    /* mem mgt abort? */
     qevent = qevent | EV_MAC;                           /* set MAC intr */
     if (cpu_unit.flags & UNIT_832)                      /* 832? restore PC */
         PC = oPC;
     }
+#endif
 
 /* Event handling */
 
@@ -655,9 +693,18 @@ while (reason == 0) {                                   /* loop until halted */
     uint32 op, r1, r1p1, r2, rx2, ea = 0;
     uint32 mpy, mpc, dvr;
     uint32 i, rslt, rlo, t;
-    uint32 ir1, ir2, ir3, ityp;
+    uint32 ir1, ir2 = 0, ir3 = 0, ityp;
     int32 sr, st;
 
+#if defined (ID32_NO_SETJMP)
+    if (mem_abort) {                                    /* mem mgt abort? */
+        mem_abort = 0;
+        qevent = qevent | EV_MAC;                       /* set MAC intr */
+        if (cpu_unit.flags & UNIT_832)                  /* 832? restore PC */
+            PC = oPC;
+        }
+#endif
+
     if (sim_interval <= 0) {                            /* check clock queue */
         if ((reason = sim_process_event ()))
             break;
@@ -686,9 +733,13 @@ while (reason == 0) {                                   /* loop until halted */
                         continue;
                     blk_io.dfl = blk_io.dfl & ~BL_LZ;   /* non-zero seen */
                     WriteB (blk_io.cur, t, VW);         /* write mem */
+                    if (MEM_ABORT)                      /* aborted? */
+                        continue;
                     }
                 else {                                  /* write */
                     t = ReadB (blk_io.cur, VR);         /* read mem */
+                    if (MEM_ABORT)                      /* aborted? */
+                        continue;
                     dev_tab[dev] (dev, IO_WD, t);       /* put byte */
                     }
                 if (blk_io.cur != blk_io.end) {         /* more to do? */
@@ -726,6 +777,8 @@ while (reason == 0) {                                   /* loop until halted */
     sim_interval = sim_interval - 1;
 
     ir1 = ReadH (oPC = PC, VE);                         /* fetch instr */
+    if (MEM_ABORT)                                      /* aborted? */
+        continue;
     op = (ir1 >> 8) & 0xFF;                             /* extract op,R1,R2 */
     r1 = (ir1 >> 4) & 0xF;
     r2 = ir1 & 0xF;
@@ -757,6 +810,8 @@ while (reason == 0) {                                   /* loop until halted */
 
     case OP_RI1:                                        /* reg-imm 1 */
         ir2 = ReadH ((PC + 2) & VAMASK, VE);            /* fetch immed */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         opnd = SEXT16 (ir2);                            /* sign extend */
         if (r2)                                         /* index calculation */
             opnd = (opnd + R[r2]) & DMASK32;
@@ -766,6 +821,8 @@ while (reason == 0) {                                   /* loop until halted */
     case OP_RI2:                                        /* reg-imm 2 */
         ir2 = ReadH ((PC + 2) & VAMASK, VE);            /* fetch imm hi */
         ir3 = ReadH ((PC + 4) & VAMASK, VE);            /* fetch imm lo */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         opnd = (ir2 << 16) | ir3;                       /* 32b immediate */
         if (r2)                                         /* index calculation */
             opnd = (opnd + R[r2]) & DMASK32;
@@ -774,6 +831,8 @@ while (reason == 0) {                                   /* loop until halted */
 
     case OP_RX: case OP_RXB: case OP_RXH: case OP_RXF:  /* reg-mem */
         ir2 = ReadH ((PC + 2) & VAMASK, VE);            /* fetch addr */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         if ((ir2 & 0xC000) == 0) {                      /* displacement? */
             PC = (PC + 4) & VAMASK;                     /* increment PC */
             ea = ir2;                                   /* abs 14b displ */
@@ -786,6 +845,8 @@ while (reason == 0) {                                   /* loop until halted */
             rx2 = (ir2 >> 8) & 0xF;                     /* get second index */
             ea = (ir2 & 0xFF) << 16;                    /* shift to place */
             ir3 = ReadH ((PC + 4) & VAMASK, VE);        /* fetch addr lo */
+            if (MEM_ABORT)                              /* aborted? */
+                break;
             ea = ea | ir3;                              /* finish addr */
             if (rx2)                                    /* index calc 2 */
                 ea = ea + R[rx2];
@@ -809,6 +870,8 @@ while (reason == 0) {                                   /* loop until halted */
         return SCPE_IERR;
         }
 
+    if (MEM_ABORT)                                      /* abort on fetch? */
+        continue;
     if (hst_lnt) {                                      /* instruction history? */
         hst[hst_p].pc = oPC | HIST_PC;                  /* save decode state */
         hst[hst_p].ir1 = ir1;
@@ -852,7 +915,10 @@ while (reason == 0) {                                   /* loop until halted */
         break;
 
     case 0x63:                                          /* LRA - RX */
-        cc = RelocT (R[r1] & VAMASK, ea, VR, &R[r1]);   /* test reloc */
+        t = RelocT (R[r1] & VAMASK, ea, VR, &R[r1]);    /* test reloc */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
+        cc = t;
         break;
 
     case 0x40:                                          /* STH - RX */
@@ -865,7 +931,10 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0xD1:                                          /* LM - RX */
         for ( ; r1 <= 0xF; r1++) {                      /* loop thru reg */
-            R[r1] = ReadF (ea, VR);                     /* load register */
+            t = ReadF (ea, VR);                         /* get value */
+            if (MEM_ABORT)                              /* aborted? */
+                break;
+            R[r1] = t;                                  /* load register */
             ea = (ea + 4) & VAMASK;                     /* incr mem addr */
             }
         break;
@@ -1139,6 +1208,8 @@ while (reason == 0) {                                   /* loop until halted */
         t = 1u << (15 - (R[r1] & 0xF));                 /* bit mask in HW */
         ea = (ea + ((R[r1] >> 3) & ~1)) & VAMASK;       /* HW location */
         opnd = ReadH (ea, VR);                          /* read HW */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         if (opnd & t)                                   /* test bit */
             cc = CC_G;
         else cc = 0;
@@ -1149,6 +1220,8 @@ while (reason == 0) {                                   /* loop until halted */
         ea = (ea + ((R[r1] >> 3) & ~1)) & VAMASK;       /* HW location */
         opnd = ReadH (ea, VR);                          /* read HW */
         WriteH (ea, opnd | t, VW);                      /* set bit, rewr */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         if (opnd & t)                                   /* test bit */
             cc = CC_G;
         else cc = 0;
@@ -1159,6 +1232,8 @@ while (reason == 0) {                                   /* loop until halted */
         ea = (ea + ((R[r1] >> 3) & ~1)) & VAMASK;       /* HW location */
         opnd = ReadH (ea, VR);                          /* read HW */
         WriteH (ea, opnd & ~t, VW);                     /* clr bit, rewr */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         if (opnd & t)                                   /* test bit */
             cc = CC_G;
         else cc = 0;
@@ -1169,6 +1244,8 @@ while (reason == 0) {                                   /* loop until halted */
         ea = (ea + ((R[r1] >> 3) & ~1)) & VAMASK;       /* HW location */
         opnd = ReadH (ea, VR);                          /* read HW */
         WriteH (ea, opnd ^ t, VW);                      /* com bit, rewr */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         if (opnd & t)                                   /* test bit */
             cc = CC_G;
         else cc = 0;
@@ -1194,6 +1271,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x51:                                          /* AM - RXF */
         rslt = (R[r1] + opnd) & DMASK32;                /* result */
         WriteF (ea, rslt, VW);                          /* write result */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         CC_GL_32 (rslt);                                /* set G,L */
         if (rslt < opnd)                                /* set C if carry */
             cc = cc | CC_C;
@@ -1204,6 +1283,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x61:                                          /* AHM - RXH */
         rslt = (R[r1] + opnd) & DMASK16;                /* result */
         WriteH (ea, rslt, VW);                          /* write result */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         CC_GL_16 (rslt);                                /* set G,L 16b */
         if (rslt < (opnd & DMASK16))                    /* set C if carry */
             cc = cc | CC_C;
@@ -1329,6 +1410,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x38:                                          /* LDR - NO */
     case 0x68:                                          /* LE - RX */
     case 0x78:                                          /* LD - RX */
+        if (FP_ABORT (op, ea))                          /* probe mem opnd */
+            break;
         cc = f_l (op, r1, r2, ea);                      /* load */
         if ((cc & CC_V) && (PSW & PSW_AFI))             /* V set? */
             cc = exception (AFIPSW, cc, 1);
@@ -1338,6 +1421,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x39:                                          /* CDR - NO */
     case 0x69:                                          /* CE - RX */
     case 0x79:                                          /* CD - RX */
+        if (FP_ABORT (op, ea))                          /* probe mem opnd */
+            break;
         cc = f_c (op, r1, r2, ea);                      /* compare */
         break;
 
@@ -1349,6 +1434,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x6B:                                          /* SE - RX */
     case 0x7A:                                          /* AD - RX */
     case 0x7B:                                          /* SD - RX */
+        if (FP_ABORT (op, ea))                          /* probe mem opnd */
+            break;
         cc = f_as (op, r1, r2, ea);                     /* add/sub */
         if ((cc & CC_V) && (PSW & PSW_AFI))             /* V set? */
             cc = exception (AFIPSW, cc, 1);
@@ -1358,6 +1445,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x3C:                                          /* MDR - NO */
     case 0x6C:                                          /* ME - RX */
     case 0x7C:                                          /* MD - RX */
+        if (FP_ABORT (op, ea))                          /* probe mem opnd */
+            break;
         cc = f_m (op, r1, r2, ea);                      /* multiply */
         if ((cc & CC_V) && (PSW & PSW_AFI))             /* V set? */
             cc = exception (AFIPSW, cc, 1);
@@ -1367,6 +1456,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x3D:                                          /* DDR - NO */
     case 0x6D:                                          /* DE - RX */
     case 0x7D:                                          /* DD - RX */
+        if (FP_ABORT (op, ea))                          /* probe mem opnd */
+            break;
         cc = f_d (op, r1, r2, ea);                      /* perform divide */
         if ((cc & CC_V) && (PSW & PSW_AFI))             /* V set? */
             cc = exception (AFIPSW, cc, 1);
@@ -1403,6 +1494,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0x72:                                          /* LME - RX */
         for ( ; r1 <= 0xE; r1 = r1 + 2) {               /* loop thru reg */
             t = ReadF (ea, VR);                         /* get value */
+            if (MEM_ABORT)                              /* aborted? */
+                break;
             WriteFReg (r1, t);                          /* write reg */
             ea = (ea + 4) & VAMASK;                     /* incr mem addr */
             }
@@ -1418,8 +1511,14 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0x7F:                                          /* LMD - RX */
         for ( ; r1 <= 0xE; r1 = r1 + 2) {               /* loop thru reg */
-            D[r1 >> 1].h = ReadF (ea, VR);              /* load register */
-            D[r1 >> 1].l = ReadF ((ea + 4) & VAMASK, VR);
+            t = ReadF (ea, VR);                         /* get value */
+            if (MEM_ABORT)                              /* aborted? */
+                break;
+            D[r1 >> 1].h = t;                           /* load register */
+            t = ReadF ((ea + 4) & VAMASK, VR);
+            if (MEM_ABORT)                              /* aborted? */
+                break;
+            D[r1 >> 1].l = t;
             ea = (ea + 8) & VAMASK;                     /* incr mem addr */
             }
         break;
@@ -1451,12 +1550,20 @@ while (reason == 0) {                                   /* loop until halted */
             t = ea + CCB32_B1C;
         else t = ea + CCB32_B0C;
         sr = ReadH (t & VAMASK, VR);                    /* get count */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         sr = SEXT16 (sr);                               /* sign extend */
         if (sr <= 0) {                                  /* <= 0? */
             bufa = ReadF ((t + 2) & VAMASK, VR);        /* get buf end */
-            if (opnd & CCW32_WR)                        /* write? */
-                R[r1] = ReadB ((bufa + sr) & VAMASK, VR);  /* R1 gets mem */
+            if (opnd & CCW32_WR) {                      /* write? */
+                rslt = ReadB ((bufa + sr) & VAMASK, VR); /* get mem */
+                if (MEM_ABORT)                          /* aborted? */
+                    break;
+                R[r1] = rslt;                           /* R1 gets mem */
+                }
             else WriteB ((bufa + sr) & VAMASK, R[r1], VW); /* read, R1 to mem */
+            if (MEM_ABORT)                              /* aborted? */
+                break;
             sr = sr + 1;                                /* inc count */
             CC_GL_32 (sr & DMASK32);                    /* set cc's */
             WriteH (t & VAMASK, sr, VW);                /* rewrite */
@@ -1479,7 +1586,10 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0xC2:                                          /* LPSW - RXF */
         PCQ_ENTRY;                                      /* effective branch */
-        PC = ReadF ((ea + 4) & VAMASK, VR) & VAMASK;    /* new PC */
+        t = ReadF ((ea + 4) & VAMASK, VR);              /* get new PC */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
+        PC = t & VAMASK;                                /* new PC */
         if (DEBUG_PRI (cpu_dev, LOG_CPU_C))
             fprintf (sim_deb, ">>LPSW: oPC = %X, oPSW = %X, nPC = %X, nPSW = %X\n",
                      pcq[pcq_p], BUILD_PSW (cc), PC, opnd);
@@ -1497,12 +1607,18 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0x64:                                          /* ATL - RX */
     case 0x65:                                          /* ABL - RX */
-        cc = addtoq (ea, R[r1], op & 1);                /* add to q */
+        t = addtoq (ea, R[r1], op & 1);                 /* add to q */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
+        cc = t;
         break;
 
     case 0x66:                                          /* RTL - RX */
     case 0x67:                                          /* RBL - RX */
-        cc = remfmq (ea, r1, op & 1);                   /* rem from q */
+        t = remfmq (ea, r1, op & 1);                    /* rem from q */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
+        cc = t;
         break;
 
     case 0x5E:                                          /* CRC12 - RXH */
@@ -1530,6 +1646,8 @@ while (reason == 0) {                                   /* loop until halted */
     case 0xE7:                                          /* TLATE - RXF */
         t = (opnd + ((R[r1] & DMASK8) << 1)) & VAMASK;  /* table entry */
         rslt = ReadH (t, VR);                           /* get entry */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         if (rslt & SIGN16)                              /* direct xlate? */
             R[r1] = rslt & DMASK8;
         else {
@@ -1542,6 +1660,8 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0xDE:                                          /* OC - RX */
         opnd = ReadB (ea, VR);                          /* fetch operand */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
     case 0x9E:                                          /* OCR - RR */
         dev = R[r1] & DEV_MAX;
         if (DEV_ACC (dev)) {
@@ -1555,6 +1675,8 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0xDA:                                          /* WD - RX */
         opnd = ReadB (ea, VR);                          /* fetch operand */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
     case 0x9A:                                          /* WDR - RR */
         dev = R[r1] & DEV_MAX;
         if (DEV_ACC (dev)) {
@@ -1568,6 +1690,8 @@ while (reason == 0) {                                   /* loop until halted */
 
     case 0xD8:                                          /* WH - RX */
         opnd = ReadH (ea, VR);                          /* fetch operand */
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
     case 0x98:                                          /* WHR - RR */
         dev = R[r1] & DEV_MAX;
         if (DEV_ACC (dev)) {
@@ -1635,6 +1759,8 @@ while (reason == 0) {                                   /* loop until halted */
         if (OP_TYPE (op) != OP_RR)                      /* RX or RR? */
             WriteB (ea, t, VW);
         else R[r2] = t & DMASK8;
+        if (MEM_ABORT)                                  /* aborted? */
+            break;
         cc = t & 0xF;
         int_eval ();                                    /* re-eval intr */
         break;
@@ -1656,6 +1782,8 @@ while (reason == 0) {                                   /* loop until halted */
             if (OP_TYPE (op) != OP_RR)
                 lim = ReadF ((ea + 4) & VAMASK, VR);
             else lim = R[(r2 + 1) & 0xF];
+            if (MEM_ABORT)                              /* aborted? */
+                break;
             if (opnd > lim)                             /* start > end? */
                 cc = 0;
             else {                                      /* no, start I/O */
@@ -1676,6 +1804,8 @@ while (reason == 0) {                                   /* loop until halted */
             if (OP_TYPE (op) != OP_RR)
                 lim = ReadF ((ea + 4) & VAMASK, VR);
             else lim = R[(r2 + 1) & 0xF];
+            if (MEM_ABORT)                              /* aborted? */
+                break;
             if (opnd > lim)                             /* start > end? */
                 cc = 0;
             else {                                      /* no, start I/O */
@@ -1718,6 +1848,25 @@ pcq_r->qptr = pcq_p;                                    /* update pc q ptr */
 return reason;
 }
 
+/* Probe a floating point memory operand
+
+   The floating point routines modify the floating point registers
+   after reading a memory operand.  Without setjmp, the operand is
+   read here first so that an abort leaves the registers unchanged.
+*/
+
+#if defined (ID32_NO_SETJMP)
+t_bool fp_probe (uint32 op, uint32 ea)
+{
+if (OP_TYPE (op) > OP_RR) {                             /* mem ref? */
+    ReadF (ea, VR);                                     /* probe hi */
+    if (OP_DPFP (op))                                   /* dp? probe lo */
+        ReadF (ea + 4, VR);
+    }
+return MEM_ABORT;
+}
+#endif
+
 /* Load new PSW */
 
 uint32 newPSW (uint32 val)
@@ -1833,7 +1982,10 @@ else {
         t = 0;
     WriteH ((ea + Q32_TOP) & VAMASK, t, VW);            /* rewrite top */
     }
-R[r1] = ReadF ((ea + Q32_BASE + (rda * Q32_SLNT)) & VAMASK, VR); /* read slot */
+t = ReadF ((ea + Q32_BASE + (rda * Q32_SLNT)) & VAMASK, VR); /* read slot */
+if (MEM_ABORT)                                          /* aborted? */
+    return 0;
+R[r1] = t;
 if (usd)
     return CC_G;
 else return 0;
@@ -2025,6 +2177,8 @@ uint32 Reloc (uint32 va, uint32 rel)
 {
 uint32 seg, off, mapr, lim;
 
+if (MEM_ABORT)                                          /* abort pending? */
+    return 0;
 seg = VA_GETSEG (va);                                   /* get seg num */
 off = VA_GETOFF (va);                                   /* get offset */
 mapr = mac_reg[seg];                                    /* get seg reg */
@@ -2032,10 +2186,12 @@ lim = GET_SRL (mapr);                                   /* get limit */
 if (off >= lim) {                                       /* limit viol? */
     mac_sta = MACS_L;                                   /* set status */
     ABORT (MPRO);                                       /* abort */
+    return 0;
     }
 if ((mapr & SR_PRS) == 0) {                             /* not present? */
     mac_sta = MACS_NP;                                  /* set status */
     ABORT (MPRO);                                       /* abort */
+    return 0;
     }
 if ((rel == VE) && (mapr & SR_EXP)) {                   /* exec, prot? */
     mac_sta = MACS_EX;                                  /* set status */
@@ -2045,6 +2201,7 @@ if ((rel == VW) && (mapr & (SR_WPI | SR_WRP))) {        /* write, prot? */
     if (mapr & SR_WRP) {                                /* write abort? */
         mac_sta = MACS_WP;                              /* set status */
         ABORT (MPRO);                                   /* abort */
+        return 0;
         }
     else {                                              /* write intr */
         mac_sta = MACS_WI;                              /* set status */
@@ -2061,6 +2218,8 @@ uint32 seg, off, mapr, lim;
 seg = VA_GETSEG (va);                                   /* get seg num */
 off = VA_GETOFF (va);                                   /* get offset */
 mapr = ReadF ((base + (seg << 2)) & VAMASK, rel);       /* get seg reg */
+if (MEM_ABORT)                                          /* aborted? */
+    return 0;
 lim = GET_SRL (mapr);                                   /* get limit */
 if (off >= lim)                                         /* limit viol? */
     return CC_C; 
@@ -2168,7 +2327,7 @@ if ((PSW & PSW_REL) == 0) {                             /* reloc off? */
     }
 else if (rel != 0)                                      /* !phys? relocate */
     pa = Reloc (loc, rel);
-if (MEM_ADDR_OK (pa))
+if (MEM_ADDR_OK (pa) && !MEM_ABORT)
     M[pa >> 2] = (M[pa >> 2] & ~(DMASK8 << sc)) | (val << sc);
 return;
 }
@@ -2192,7 +2351,7 @@ if ((PSW & PSW_REL) == 0) {                             /* reloc off? */
     }
 else if (rel != 0)                                      /* !phys? relocate */
     pa = Reloc (loc, rel);
-if (MEM_ADDR_OK (pa))
+if (MEM_ADDR_OK (pa) && !MEM_ABORT)
     M[pa >> 2] = (loc & 2)? ((M[pa >> 2] & ~DMASK16) | val):
                             ((M[pa >> 2] & DMASK16) | (val << 16));
 return;
@@ -2220,7 +2379,7 @@ if ((PSW & PSW_REL) == 0) {                             /* reloc off? */
     }
 else if (rel != 0)                                      /* !phys? relocate */
     pa = Reloc (loc, rel);
-if (MEM_ADDR_OK (pa))
+if (MEM_ADDR_OK (pa) && !MEM_ABORT)
     M[pa >> 2] = val & DMASK32;
 return;
 }
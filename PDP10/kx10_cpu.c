@@ -170,6 +170,9 @@ int32   apr_serial = -1;                      /* CPU Serial number */
 int     inout_fail;                           /* In out fail flag */
 int     small_user;                           /* Small user flag */
 int     user_addr_cmp;                        /* User address compare flag */
+uint64  *pag_rd[2][512];                      /* Readable page by context */
+uint64  *pag_wr[2][512];                      /* Writable page by context */
+int16   pag_last[2][512];                     /* Last page mapped, or -1 */
 #endif
 #if KI | ITS | BBN
 uint32  e_tlb[512];                           /* Executive TLB */
@@ -281,6 +284,8 @@ t_stat cpu_show_hist (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 #if KI
 t_stat cpu_set_serial (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_serial (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+void pag_clear (void);
+void pag_clear_tlb (int user, int idx);
 #endif
 t_stat cpu_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag,
                      const char *cptr);
@@ -1115,6 +1120,7 @@ t_stat dev_pag(uint32 dev, uint64 *data) {
                e_tlb[i] = u_tlb[i] = 0;
             for (;i < 546; i++)
                u_tlb[i] = 0;
+            pag_clear();
             page_enable = (res & 020000) != 0;
         }
         if (res & SMASK) {
@@ -1123,6 +1129,7 @@ t_stat dev_pag(uint32 dev, uint64 *data) {
                e_tlb[i] = u_tlb[i] = 0;
             for (;i < 546; i++)
                u_tlb[i] = 0;
+            pag_clear();
             user_addr_cmp = (res & 00020000000000LL) != 0;
             small_user =    (res & 00040000000000LL) != 0;
             fm_sel = (uint8)(res >> 29) & 060;
@@ -1419,6 +1426,52 @@ sim_debug(DEBUG_DATAIO, &cpu_dev, "Rl=%06o Pl=%06o, Rh=%06o, Ph=%06o\n", Rl, Pl,
 
 
 #if KI
+/*
+ * Page cache for KI10.
+ *
+ * When page_lookup maps a private page without a fault, the address of
+ * the physical page in M is saved by context (exec or user) and virtual
+ * page, for reads and, if the page is writable, for writes, along with
+ * the last_page value.  Mem_read and Mem_write then use the saved page
+ * directly unless a page fault is pending, PUBLIC is set, an XCT could
+ * make the reference a user one, or breakpoints are set.  Entries are
+ * cleared with the TLB entries they came from.
+ */
+void pag_clear() {
+    memset(pag_rd, 0, sizeof(pag_rd));
+    memset(pag_wr, 0, sizeof(pag_wr));
+}
+
+/*
+ * Clear the cache entries for the pair of user or executive TLB
+ * entries holding idx.
+ */
+void pag_clear_tlb(int user, int idx) {
+    int  ctx = user;
+
+    idx &= 01776;
+    /* Exec pages 340-377 are mapped by the user TLB */
+    if (idx >= 01000) {
+        idx += 0340 - 01000;
+        ctx = 0;
+    }
+    pag_rd[ctx][idx] = pag_rd[ctx][idx|1] = NULL;
+    pag_wr[ctx][idx] = pag_wr[ctx][idx|1] = NULL;
+}
+
+/*
+ * Save a mapped page in the page cache.
+ */
+void pag_fill(int ctx, int page, int loc, int last, int wr) {
+    uint64  *p = &M[loc & ~0777];
+
+    if ((loc | 0777) >= (int)MEMSIZE)
+        return;
+    pag_rd[ctx][page] = p;
+    pag_wr[ctx][page] = wr ? p : NULL;
+    pag_last[ctx][page] = last;
+}
+
 /*
  * Handle page lookup on KI10
  *
@@ -1491,6 +1544,7 @@ int page_lookup(int addr, int flag, int *loc, int wr, int cur_context, int fetch
                 page_fault = 1;
                 return !wr;
             }
+            pag_fill(0, page, addr, -1, 1);
             return 1;
         }
     }
@@ -1502,6 +1556,7 @@ int page_lookup(int addr, int flag, int *loc, int wr, int cur_context, int fetch
            e_tlb[page & 0776] = RMASK & (data >> 18);
            e_tlb[page | 1] = RMASK & data;
            data = e_tlb[page];
+           pag_clear_tlb(0, page);
            pag_reload = ((pag_reload + 1) & 037) | 040;
         }
         last_page = ((page ^ 0777) << 1)|1;
@@ -1512,6 +1567,7 @@ int page_lookup(int addr, int flag, int *loc, int wr, int cur_context, int fetch
            u_tlb[page & 01776] = RMASK & (data >> 18);
            u_tlb[page | 1] = RMASK & data;
            data = u_tlb[page];
+           pag_clear_tlb(1, page);
            pag_reload = ((pag_reload + 1) & 037) | 040;
         }
         if (upmp)
@@ -1545,6 +1601,9 @@ int page_lookup(int addr, int flag, int *loc, int wr, int cur_context, int fetch
     /* If fetching from public page, set public flag */
     if (fetch && ((data & 0200000) != 0))
         FLAGS |= PUBLIC;
+    /* Only private pages can be cached */
+    if ((data & 0200000) == 0)
+        pag_fill(uf, (RMASK & addr) >> 9, *loc, last_page, (data & 0100000) != 0);
     return 1;
 }
 
@@ -1627,6 +1686,24 @@ int Mem_read(int flag, int cur_context, int fetch) {
     } else {
 read:
         sim_interval--;
+        /* Try page cache first */
+        if (!page_fault && !sim_brk_summ && (FLAGS & PUBLIC) == 0 &&
+            (flag || cur_context || xct_flag == 0 || (FLAGS & USER) != 0)) {
+            int      ctx = !flag && (FLAGS & USER) != 0;
+            int      page = (RMASK & AB) >> 9;
+            uint64  *p;
+
+            if (modify || (BYF5 && (IR & 06) == 6))
+                p = pag_wr[ctx][page];
+            else
+                p = pag_rd[ctx][page];
+            if (p != NULL) {
+                if (pag_last[ctx][page] >= 0)
+                    last_page = pag_last[ctx][page];
+                MB = p[AB & 0777];
+                return 0;
+            }
+        }
         if (!page_lookup(AB, flag, &addr, 0, cur_context, fetch))
             return 1;
         if (addr >= (int)MEMSIZE) {
@@ -1666,6 +1743,20 @@ int Mem_write(int flag, int cur_context) {
     } else {
 write:
         sim_interval--;
+        /* Try page cache first */
+        if (!page_fault && !sim_brk_summ && (FLAGS & PUBLIC) == 0 &&
+            (flag || cur_context || xct_flag == 0 || (FLAGS & USER) != 0)) {
+            int      ctx = !flag && (FLAGS & USER) != 0;
+            int      page = (RMASK & AB) >> 9;
+            uint64  *p = pag_wr[ctx][page];
+
+            if (p != NULL) {
+                if (pag_last[ctx][page] >= 0)
+                    last_page = pag_last[ctx][page];
+                p[AB & 0777] = MB;
+                return 0;
+            }
+        }
         if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
             return 1;
         if (addr >= (int)MEMSIZE) {
@@ -5024,6 +5115,7 @@ left:
                      e_tlb[f & 0776] = RMASK & (AR >> 18);
                      e_tlb[f | 1] = RMASK & AR;
                      AR = e_tlb[f];
+                     pag_clear_tlb(0, f);
                      if (AR == 0) {
                          AR = 0437777;
                          set_reg(AC, AR);
@@ -5039,6 +5131,7 @@ left:
                      u_tlb[f & 01776] = RMASK & (AR >> 18);
                      u_tlb[f | 1] = RMASK & AR;
                      AR = u_tlb[f];
+                     pag_clear_tlb(1, f);
                      if (AR == 0) {
                          AR = 0437777;
                          set_reg(AC, AR);
@@ -6053,6 +6146,9 @@ ub_ptr = eb_ptr = 0;
 pag_reload = ac_stack = 0;
 fm_sel = small_user = user_addr_cmp = page_enable = 0;
 #endif
+#if KI
+pag_clear();
+#endif
 #if BBN
 exec_map = 0;
 #endif
@@ -6130,6 +6226,9 @@ if (val < (int32)MEMSIZE) {
 for (i = (int32)MEMSIZE; i < val; i++)
     M[i] = 0;
 cpu_unit[0].capac = (uint32)val;
+#if KI
+pag_clear();
+#endif
 return SCPE_OK;
 }
 
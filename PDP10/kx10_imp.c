@@ -145,8 +145,12 @@
 #endif
 #endif
 
-#define IMP_ARPTAB_SIZE        64
+#define IMP_ARPTAB_SIZE        64               /* Initial ARP table slots */
+#define IMP_ARPTAB_MAX         4096             /* Entries before reuse of oldest */
 #define IMP_ARP_MAX_AGE        100
+#define IMP_PORTMAP_SIZE       64               /* Initial port map slots */
+#define IMP_PORTMAP_MAX        1024             /* Entries before reuse of oldest */
+#define IMP_PORTMAP_MAX_AGE    36000            /* Idle ticks before entry dropped */
 
 uint32 mask[] = {
      0xFFFFFFFF, 0xFFFFFFFE, 0xFFFFFFFC, 0xFFFFFFF8,
@@ -385,6 +389,7 @@ struct imp_map {
     uint16            sport;                   /* Port to fix */
     uint16            dport;                   /* Port to fix */
     uint16            cls_tim;                 /* Close timer */
+    uint16            age;                     /* Ticks since last used */
     uint32            adj;                     /* Amount to adjust */
     uint32            lseq;                    /* Sequence number last adjusted */
 };
@@ -417,7 +422,9 @@ struct imp_device {
     in_addr_T         hostip;                  /* IP address of local host */
     in_addr_T         gwip;                    /* Gateway IP address */
     int               maskbits;                /* Mask length */
-    struct imp_map    port_map[64];            /* Ports to adjust */
+    struct imp_map    *port_map;               /* Ports to adjust (hashed) */
+    int               port_map_size;           /* Slots in port_map */
+    int               port_map_count;          /* Slots in use */
     in_addr_T         dhcpip;                  /* DHCP server address */
     uint8             dhcp_state;              /* State of DHCP */
     int               dhcp_lease;              /* DHCP lease time */
@@ -441,7 +448,9 @@ struct imp_device {
     int               host_error;
     int               rfnm_count;              /* Number of pending RFNM packets */
     int               pia;                     /* PIA channels */
-    struct arp_entry  arp_table[IMP_ARPTAB_SIZE];
+    struct arp_entry  *arp_table;              /* ARP cache (hashed) */
+    int               arp_size;                /* Slots in arp_table */
+    int               arp_count;               /* Slots in use */
 } imp_data;
 
 extern int32 tmxr_poll;
@@ -478,6 +487,11 @@ void           imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC
 void           imp_arp_arpin(struct imp_device *imp, ETH_PACK *packet);
 void           imp_arp_arpout(struct imp_device *imp, in_addr_T ipaddr);
 struct arp_entry * imp_arp_lookup(struct imp_device *imp, in_addr_T ipaddr);
+void           imp_arp_clear(struct imp_device *imp);
+struct imp_map * imp_map_lookup(struct imp_device *imp, uint16 sport, uint16 dport);
+struct imp_map * imp_map_add(struct imp_device *imp, uint16 sport, uint16 dport);
+void           imp_map_resize(struct imp_device *imp, int size);
+void           imp_map_clear(struct imp_device *imp);
 void           imp_packet_out(struct imp_device *imp, ETH_PACK *packet);
 void           imp_packet_debug(struct imp_device *imp, const char *action, ETH_PACK *packet);
 void           imp_write(struct imp_device *imp, ETH_PACK *packet);
@@ -778,6 +792,47 @@ t_stat imp_srv(UNIT * uptr)
     return SCPE_OK;
 }
 
+/*
+ * Sum "len" bytes at "ptr" as 16 bit words, 32 bits at a time.
+ *
+ * The one's complement sum is independent of byte order (RFC1071), so
+ * words are added in host order and the folded result is stored back
+ * in host order, which leaves it in network order in the packet.
+ */
+static uint16
+ip_sum(uint8 *ptr, int len)
+{
+    t_uint64  sum = 0;
+    uint32    w;
+    uint16    h;
+
+    while (len >= 4) {
+        memcpy(&w, ptr, sizeof(w));
+        sum += w;
+        ptr += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        memcpy(&h, ptr, sizeof(h));
+        sum += h;
+        ptr += 2;
+        len -= 2;
+    }
+    /*  Add left-over byte, if any, as the high order byte of a word */
+    if (len > 0) {
+        uint8     b[2];
+
+        b[0] = ptr[0];
+        b[1] = 0;
+        memcpy(&h, b, sizeof(h));
+        sum += h;
+    }
+    /*  Fold 64-bit sum to 16 bits */
+    while (sum >> 16)
+       sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16)sum;
+}
+
 void
 ip_checksum(uint8 *chksum, uint8 *ptr, int len)
 {
@@ -785,25 +840,9 @@ ip_checksum(uint8 *chksum, uint8 *ptr, int len)
     * Compute Internet Checksum for "count" bytes
     *         beginning at location "addr".
     */
-   int32  sum = 0;
-
-   while( len > 1 )  {
-      /*  This is the inner loop */
-      sum += (ptr[0]<<8)+ptr[1];
-      ptr+=2;
-      len -= 2;
-   }
+    uint16   sum = (uint16)~ip_sum(ptr, len);
 
-   /*  Add left-over byte, if any */
-   if( len > 0 )
-      sum += ptr[0]<<8;
-
-    /*  Fold 32-bit sum to 16 bits */
-    while (sum>>16)
-       sum = (sum & 0xffff) + (sum >> 16);
-    sum=(~sum & 0xffff);
-    chksum[0]=(sum>>8) & 0xff;
-    chksum[1]=sum & 0xff;
+    memcpy(chksum, &sum, sizeof(sum));
 }
 
 
@@ -820,36 +859,20 @@ checksumadjust(uint8 *chksum, uint8 *optr,
      - even number of octets updated.
    */
 {
-    int32 sum, old, new_sum;
-    sum=(chksum[0]<<8)+chksum[1];
-    sum=(~sum & 0xffff);
-    while (olen > 1) {
-        old=(optr[0]<<8)+optr[1];
-        optr+=2;
-        sum-=old & 0xffff;
-        if (sum<=0) { sum--; sum&=0xffff; }
-        olen-=2;
-    }
-    if (olen > 0) {
-        old=optr[0]<<8;
-        sum-=old & 0xffff;
-        if (sum<=0) { sum--; sum&=0xffff; }
-    }
-    while (nlen > 1) {
-        new_sum=(nptr[0]<<8)+nptr[1];
-        nptr+=2;
-        sum+=new_sum & 0xffff;
-        if (sum & 0x10000) { sum++; sum&=0xffff; }
-        nlen-=2;
-    }
-    if (nlen > 0) {
-        new_sum=(nptr[0]<<8);
-        sum+=new_sum & 0xffff;
-        if (sum & 0x10000) { sum++; sum&=0xffff; }
-    }
-    sum=(~sum & 0xffff);
-    chksum[0]=sum>>8;
-    chksum[1]=sum & 0xff;
+    uint16 hc;
+    uint32 sum;
+
+    /* HC' = ~(~HC + ~m + m') as in RFC1624, summed a word at a time */
+    memcpy(&hc, chksum, sizeof(hc));
+    sum = (uint16)~hc;
+    if (olen > 0)
+        sum += (uint16)~ip_sum(optr, olen);
+    if (nlen > 0)
+        sum += ip_sum(nptr, nlen);
+    while (sum >> 16)
+       sum = (sum & 0xffff) + (sum >> 16);
+    hc = (uint16)~sum;
+    memcpy(chksum, &hc, sizeof(hc));
 }
 
 t_stat imp_eth_srv(UNIT * uptr)
@@ -888,22 +911,143 @@ t_stat imp_eth_srv(UNIT * uptr)
     return SCPE_OK;
 }
 
+/*
+ * Hash a 32 bit key into a power of 2 sized open addressed table.
+ */
+static int
+imp_hash(uint32 key, int size)
+{
+    key *= 0x9E3779B1;
+    return (int)((key ^ (key >> 16)) & (uint32)(size - 1));
+}
+
+/*
+ * Find the sequence adjustment for a TCP connection.
+ */
+struct imp_map *
+imp_map_lookup(struct imp_device *imp, uint16 sport, uint16 dport)
+{
+    int                i;
+
+    if (imp->port_map_count == 0)
+        return NULL;
+    i = imp_hash(((uint32)sport << 16) | dport, imp->port_map_size);
+    while (imp->port_map[i].dport != 0) {
+        if (imp->port_map[i].sport == sport &&
+            imp->port_map[i].dport == dport) {
+            imp->port_map[i].age = 0;
+            return &imp->port_map[i];
+        }
+        i = (i + 1) & (imp->port_map_size - 1);
+    }
+    return NULL;
+}
+
+/*
+ * Rehash the port map into a table of "size" slots, dropping free entries.
+ */
+void
+imp_map_resize(struct imp_device *imp, int size)
+{
+    struct imp_map    *old = imp->port_map;
+    int                old_size = imp->port_map_size;
+    int                i, j;
+
+    imp->port_map = (struct imp_map *)calloc(size, sizeof(struct imp_map));
+    if (imp->port_map == NULL) {
+        imp->port_map = old;
+        return;
+    }
+    imp->port_map_size = size;
+    imp->port_map_count = 0;
+    for (i = 0; i < old_size; i++) {
+        if (old[i].dport == 0)
+            continue;
+        j = imp_hash(((uint32)old[i].sport << 16) | old[i].dport, size);
+        while (imp->port_map[j].dport != 0)
+            j = (j + 1) & (size - 1);
+        imp->port_map[j] = old[i];
+        imp->port_map_count++;
+    }
+    free(old);
+}
+
+/*
+ * Empty the port map.
+ */
+void
+imp_map_clear(struct imp_device *imp)
+{
+    free(imp->port_map);
+    imp->port_map = NULL;
+    imp->port_map_size = 0;
+    imp->port_map_count = 0;
+}
+
+/*
+ * Find or create the sequence adjustment for a TCP connection, once the
+ * table is at its limit reuse the entry idle the longest.
+ */
+struct imp_map *
+imp_map_add(struct imp_device *imp, uint16 sport, uint16 dport)
+{
+    struct imp_map    *map;
+    int                i;
+
+    if ((map = imp_map_lookup(imp, sport, dport)) != NULL)
+        return map;
+    /* If the table is at its limit, discard the oldest entry */
+    if (imp->port_map_count >= IMP_PORTMAP_MAX) {
+        int       fnd = -1;
+        int       tmpage = -1;
+        for (i = 0; i < imp->port_map_size; i++) {
+            if (imp->port_map[i].dport != 0 && imp->port_map[i].age > tmpage) {
+                tmpage = imp->port_map[i].age;
+                fnd = i;
+            }
+        }
+        if (fnd >= 0) {
+            memset(&imp->port_map[fnd], 0, sizeof(struct imp_map));
+            imp_map_resize(imp, imp->port_map_size);
+        }
+    }
+    /* Keep the table at most 3/4 full */
+    if ((imp->port_map_count + 1) * 4 > imp->port_map_size * 3)
+        imp_map_resize(imp, (imp->port_map_size == 0) ? IMP_PORTMAP_SIZE :
+                                                         imp->port_map_size * 2);
+    if ((imp->port_map_count + 1) * 4 > imp->port_map_size * 3)
+        return NULL;
+    i = imp_hash(((uint32)sport << 16) | dport, imp->port_map_size);
+    while (imp->port_map[i].dport != 0)
+        i = (i + 1) & (imp->port_map_size - 1);
+    map = &imp->port_map[i];
+    memset(map, 0, sizeof(*map));
+    map->sport = sport;
+    map->dport = dport;
+    imp->port_map_count++;
+    return map;
+}
+
 void
 imp_timer_task(struct imp_device *imp)
 {
     struct imp_packet  *nq = NULL;                /* New send queue */
     int                 n;
+    int                 expired = 0;
 
-    /* Scan through adjusted ports and remove old ones */
-    for (n = 0; n < 64; n++) {
-        if (imp->port_map[n].cls_tim > 0) {
-            if (--imp->port_map[n].cls_tim == 0) {
-                imp->port_map[n].dport = 0;
-                imp->port_map[n].sport = 0;
-                imp->port_map[n].adj = 0;
-            }
+    /* Scan through adjusted ports and remove closed or idle ones */
+    for (n = 0; imp->port_map_count != 0 && n < imp->port_map_size; n++) {
+        struct imp_map *map = &imp->port_map[n];
+        if (map->dport == 0)
+            continue;
+        if ((map->cls_tim > 0 && --map->cls_tim == 0) ||
+            ++map->age > IMP_PORTMAP_MAX_AGE) {
+            memset(map, 0, sizeof(struct imp_map));
+            expired = 1;
         }
     }
+    if (expired)          /* Rehash to close the holes in probe chains */
+        imp_map_resize(imp, imp->port_map_size);
 
     /* Scan the send queue and see if any packets have timed out */
     while (imp->sendq != NULL) {
@@ -1021,27 +1165,23 @@ imp_packet_in(struct imp_device *imp)
                               (uint8 *)(&ip_hdr->ip_dst), sizeof(in_addr_T),
                               (uint8 *)(&imp_data.hostip), sizeof(in_addr_T));
                    if ((ntohs(tcp_hdr->flags) & 0x10) != 0) {
-                       for (n = 0; n < 64; n++) {
-                           if (imp->port_map[n].sport == sport &&
-                               imp->port_map[n].dport == dport) {
-                               /* Check if SYN */
-                               if (ntohs(tcp_hdr->flags) & 02) {
-                                   imp->port_map[n].sport = 0;
-                                   imp->port_map[n].dport = 0;
-                                   imp->port_map[n].adj = 0;
-                               } else {
-                                   uint32   new_seq = ntohl(tcp_hdr->ack);
-                                   if (new_seq > imp->port_map[n].lseq) {
-                                       new_seq = htonl(new_seq - imp->port_map[n].adj);
-                                       checksumadjust((uint8 *)&tcp_hdr->chksum,
-                                               (uint8 *)(&tcp_hdr->ack), 4,
-                                               (uint8 *)(&new_seq), 4);
-                                       tcp_hdr->ack = new_seq;
-                                   }
+                       struct imp_map *map = imp_map_lookup(imp, sport, dport);
+                       if (map != NULL) {
+                           /* Check if SYN */
+                           if (ntohs(tcp_hdr->flags) & 02) {
+                               map->cls_tim = 1;     /* Drop on next tick */
+                               map->adj = 0;
+                           } else {
+                               uint32   new_seq = ntohl(tcp_hdr->ack);
+                               if (new_seq > map->lseq) {
+                                   new_seq = htonl(new_seq - map->adj);
+                                   checksumadjust((uint8 *)&tcp_hdr->chksum,
+                                           (uint8 *)(&tcp_hdr->ack), 4,
+                                           (uint8 *)(&new_seq), 4);
+                                   tcp_hdr->ack = new_seq;
                                }
                                if (ntohs(tcp_hdr->flags) & 01)
-                                   imp->port_map[n].cls_tim = 100;
-                               break;
+                                   map->cls_tim = 100;
                            }
                        }
                     }
@@ -1070,23 +1210,12 @@ imp_packet_in(struct imp_device *imp)
                        memcpy(tcp_payload, port_buffer, nlen);
                        /* Check if we need to update the sequence numbers */
                        if (nlen != l && (ntohs(tcp_hdr->flags) & 02) == 0) {
-                           int n = -1;
-                           /* See if we need to change the sequence number */
-                           for (i = 0; i < 64; i++) {
-                               if (imp->port_map[i].sport == sport &&
-                                   imp->port_map[i].dport == dport) {
-                                   n = i;
-                                   break;
-                               }
-                               if (n < 0 && imp->port_map[i].dport == 0)
-                                   n = 0;
-                           }
-                           if (n >= 0) {
-                               imp->port_map[n].dport = dport;
-                               imp->port_map[n].sport = sport;
-                               imp->port_map[n].adj += nlen - l;
-                               imp->port_map[n].cls_tim = 0;
-                               imp->port_map[n].lseq = ntohl(tcp_hdr->seq);
+                           /* Remember the adjustment for the sequence numbers */
+                           struct imp_map *map = imp_map_add(imp, sport, dport);
+                           if (map != NULL) {
+                               map->adj += nlen - l;
+                               map->cls_tim = 0;
+                               map->lseq = ntohl(tcp_hdr->seq);
                            }
                        }
                        /* Now we need to update the checksums */
@@ -1235,6 +1364,7 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
     struct ip_hdr     *pkt = (struct ip_hdr *)(&packet->msg[0]);
     struct imp_packet *send;
     struct arp_entry  *tabptr;
+    struct imp_map    *map;
     in_addr_T          ipaddr;
     int                i;
 
@@ -1256,27 +1386,22 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
                        (uint8 *)(&pkt->iphdr.ip_src), sizeof(in_addr_T),
                        (uint8 *)(&imp->ip), sizeof(in_addr_T));
            /* See if we need to change the sequence number */
-           for (i = 0; i < 64; i++) {
-               if (imp->port_map[i].sport == sport &&
-                   imp->port_map[i].dport == dport) {
-                   /* Check if SYN */
-                   if (ntohs(tcp_hdr->flags) & 02) {
-                       imp->port_map[i].sport = 0;
-                       imp->port_map[i].dport = 0;
-                       imp->port_map[i].adj = 0;
-                   } else {
-                       uint32   new_seq = ntohl(tcp_hdr->seq);
-                       if (new_seq > imp->port_map[i].lseq) {
-                           new_seq = htonl(new_seq + imp->port_map[i].adj);
-                           checksumadjust((uint8 *)&tcp_hdr->chksum,
-                                   (uint8 *)(&tcp_hdr->seq), 4,
-                                   (uint8 *)(&new_seq), 4);
-                           tcp_hdr->seq = new_seq;
-                       }
+           if ((map = imp_map_lookup(imp, sport, dport)) != NULL) {
+               /* Check if SYN */
+               if (ntohs(tcp_hdr->flags) & 02) {
+                   map->cls_tim = 1;     /* Drop on next tick */
+                   map->adj = 0;
+               } else {
+                   uint32   new_seq = ntohl(tcp_hdr->seq);
+                   if (new_seq > map->lseq) {
+                       new_seq = htonl(new_seq + map->adj);
+                       checksumadjust((uint8 *)&tcp_hdr->chksum,
+                               (uint8 *)(&tcp_hdr->seq), 4,
+                               (uint8 *)(&new_seq), 4);
+                       tcp_hdr->seq = new_seq;
                    }
                    if (ntohs(tcp_hdr->flags) & 01)
-                       imp->port_map[i].cls_tim = 100;
-                   break;
+                       map->cls_tim = 100;
                }
            }
            /* Check if sending to FTP */
@@ -1303,23 +1428,11 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
                memcpy(tcp_payload, port_buffer, nlen);
                /* Check if we need to update the sequence numbers */
                if (nlen != l && (ntohs(tcp_hdr->flags) & 02) == 0) {
-                   int n = -1;
-                   /* See if we need to change the sequence number */
-                   for (i = 0; i < 64; i++) {
-                       if (imp->port_map[i].sport == sport &&
-                           imp->port_map[i].dport == dport) {
-                           n = i;
-                           break;
-                       }
-                       if (n < 0 && imp->port_map[i].dport == 0)
-                           n = 0;
-                   }
-                   if (n >= 0) {
-                       imp->port_map[n].dport = dport;
-                       imp->port_map[n].sport = sport;
-                       imp->port_map[n].adj += nlen - l;
-                       imp->port_map[n].cls_tim = 0;
-                       imp->port_map[n].lseq = ntohl(tcp_hdr->seq);
+                   /* Remember the adjustment for the sequence numbers */
+                   if ((map = imp_map_add(imp, sport, dport)) != NULL) {
+                       map->adj += nlen - l;
+                       map->cls_tim = 0;
+                       map->lseq = ntohl(tcp_hdr->seq);
                    }
                }
                /* Now we need to update the checksums */
@@ -1371,16 +1484,13 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
     if ((imp->ip & imp->ip_mask) != (ipaddr & imp->ip_mask))
         ipaddr = imp->gwip;
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-        if (ipaddr == tabptr->ipaddr) {
-            memcpy(&pkt->ethhdr.dest, &tabptr->ethaddr, 6);
-            memcpy(&pkt->ethhdr.src, &imp->mac, 6);
-            pkt->ethhdr.type = htons(ETHTYPE_IP);
-            imp_write(imp, packet);
-            imp->rfnm_count++;
-            return;
-         }
+    if ((tabptr = imp_arp_lookup(imp, ipaddr)) != NULL) {
+        memcpy(&pkt->ethhdr.dest, &tabptr->ethaddr, 6);
+        memcpy(&pkt->ethhdr.src, &imp->mac, 6);
+        pkt->ethhdr.type = htons(ETHTYPE_IP);
+        imp_write(imp, packet);
+        imp->rfnm_count++;
+        return;
     }
 
     /* Queue packet for later send */
@@ -1651,7 +1761,48 @@ void imp_write(struct imp_device *imp, ETH_PACK *packet) {
 }
 
 /*
- * Update the ARP table, first use free entry, else use oldest.
+ * Rehash the ARP table into a table of "size" slots, dropping free entries.
+ */
+static void
+imp_arp_resize(struct imp_device *imp, int size)
+{
+    struct arp_entry  *old = imp->arp_table;
+    int                old_size = imp->arp_size;
+    int                i, j;
+
+    imp->arp_table = (struct arp_entry *)calloc(size, sizeof(struct arp_entry));
+    if (imp->arp_table == NULL) {
+        imp->arp_table = old;
+        return;
+    }
+    imp->arp_size = size;
+    imp->arp_count = 0;
+    for (i = 0; i < old_size; i++) {
+        if (old[i].ipaddr == 0)
+            continue;
+        j = imp_hash(old[i].ipaddr, size);
+        while (imp->arp_table[j].ipaddr != 0)
+            j = (j + 1) & (size - 1);
+        imp->arp_table[j] = old[i];
+        imp->arp_count++;
+    }
+    free(old);
+}
+
+/*
+ * Empty the ARP table.
+ */
+void
+imp_arp_clear(struct imp_device *imp)
+{
+    free(imp->arp_table);
+    imp->arp_table = NULL;
+    imp->arp_size = 0;
+    imp->arp_count = 0;
+}
+
+/*
+ * Update the ARP table, growing it as needed, once full reuse the oldest.
  */
 void
 imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC *ethaddr, int age)
@@ -1661,47 +1812,48 @@ imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC *ethaddr, int a
     char               mac_buf[20];
 
     /* Check if entry already in the table. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-
-        if (tabptr->ipaddr != 0) {
-            if (tabptr->ipaddr == ipaddr) {
-                if (0 != memcmp(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC))) {
-                    memcpy(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC));
-                    eth_mac_fmt(ethaddr, mac_buf);
-                    sim_debug(DEBUG_ARP, &imp_dev,
-                              "updating entry for IP %s to %s\n", 
-                              ipv4_inet_ntoa(*((struct in_addr *)&ipaddr)), mac_buf);
-                    }
-                if (tabptr->age != ARP_DONT_AGE)
-                    tabptr->age = age;
-                return;
+    if ((tabptr = imp_arp_lookup(imp, ipaddr)) != NULL) {
+        if (0 != memcmp(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC))) {
+            memcpy(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC));
+            eth_mac_fmt(ethaddr, mac_buf);
+            sim_debug(DEBUG_ARP, &imp_dev,
+                      "updating entry for IP %s to %s\n", 
+                      ipv4_inet_ntoa(*((struct in_addr *)&ipaddr)), mac_buf);
             }
-        }
-     }
-
-    /* See if we can find an unused entry. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-
-        if (tabptr->ipaddr == 0)
-            break;
+        if (tabptr->age != ARP_DONT_AGE)
+            tabptr->age = age;
+        return;
     }
 
-    /* If no empty entry search for oldest one. */
-    if (tabptr->ipaddr != 0) {
-        int       fnd = 0;
+    /* If the table is at its limit, discard the oldest entry. */
+    if (imp->arp_count >= IMP_ARPTAB_MAX) {
+        int       fnd = -1;
         int16     tmpage = 0;
-        for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
+        for (i = 0; i < imp->arp_size; i++) {
             tabptr = &imp->arp_table[i];
-            if (tabptr->age > tmpage) {
+            if (tabptr->ipaddr != 0 && tabptr->age > tmpage) {
                 tmpage = tabptr->age;
                 fnd = i;
             }
         }
-        tabptr = &imp->arp_table[fnd];
+        if (fnd >= 0) {
+            memset(&imp->arp_table[fnd], 0, sizeof(struct arp_entry));
+            imp_arp_resize(imp, imp->arp_size);
+        }
     }
 
+    /* Keep the table at most 3/4 full. */
+    if ((imp->arp_count + 1) * 4 > imp->arp_size * 3)
+        imp_arp_resize(imp, (imp->arp_size == 0) ? IMP_ARPTAB_SIZE :
+                                                   imp->arp_size * 2);
+    if ((imp->arp_count + 1) * 4 > imp->arp_size * 3)
+        return;
+    i = imp_hash(ipaddr, imp->arp_size);
+    while (imp->arp_table[i].ipaddr != 0)
+        i = (i + 1) & (imp->arp_size - 1);
+    tabptr = &imp->arp_table[i];
+    imp->arp_count++;
+
     /* Now save the entry */
     memcpy(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC));
     tabptr->ipaddr = ipaddr;
@@ -1719,8 +1871,9 @@ void imp_arp_age(struct imp_device *imp)
 {
     struct arp_entry  *tabptr;
     int                i;
+    int                expired = 0;
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
+    for (i = 0; i < imp->arp_size; i++) {
         tabptr = &imp->arp_table[i];
         if (tabptr->ipaddr != 0) {      /* active entry? */
             if (tabptr->age != ARP_DONT_AGE)
@@ -1734,9 +1887,12 @@ void imp_arp_age(struct imp_device *imp)
                           "discarding ARP entry for IP %s %s after %d seconds\n", 
                           ipv4_inet_ntoa(*((struct in_addr *)&tabptr->ipaddr)), mac_buf, IMP_ARP_MAX_AGE);
                 memset(tabptr, 0, sizeof(*tabptr));
+                expired = 1;
             }
         }
     }
+    if (expired)                        /* Rehash to close the holes */
+        imp_arp_resize(imp, imp->arp_size);
 }
 
 
@@ -1854,14 +2010,13 @@ struct arp_entry *imp_arp_lookup(struct imp_device *imp, in_addr_T ipaddr)
     struct arp_entry  *tabptr;
     int                i;
 
-    /* Check if entry already in the table. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-
-        if (tabptr->ipaddr != 0) {
-            if (tabptr->ipaddr == ipaddr)
-                return tabptr;
-        }
+    if (imp->arp_count == 0 || ipaddr == 0)
+        return NULL;
+    i = imp_hash(ipaddr, imp->arp_size);
+    while ((tabptr = &imp->arp_table[i])->ipaddr != 0) {
+        if (tabptr->ipaddr == ipaddr)
+            return tabptr;
+        i = (i + 1) & (imp->arp_size - 1);
     }
     return NULL;
 }
@@ -1894,7 +2049,7 @@ t_stat imp_show_arp (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
 
     fprintf (st, "%-17s%-19s%s\n", "IP Address:", "MAC:", "Age:");
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
+    for (i = 0; i < imp_data.arp_size; i++) {
         char buf[32];
 
         tabptr = &imp_data.arp_table[i];
@@ -2624,11 +2779,12 @@ t_stat imp_reset (DEVICE *dptr)
         /* Set a default MAC address in a BBN assigned OID range no longer in use */
         imp_set_mac (dptr->units, 0, "00:00:02:00:00:00/24", NULL);
         /* Clear ARP table. */
-        memset(imp_data.arp_table, 0, sizeof(imp_data.arp_table));
+        imp_arp_clear(&imp_data);
         imp_data.dhcp_state = DHCP_STATE_OFF;
     }
-    /* Clear queues. */
+    /* Clear queues and sequence adjustments. */
     imp_data.sendq = NULL;
+    imp_map_clear(&imp_data);
     /* Set up free queue */
     p = NULL;
     for (i = 0; i < (sizeof(imp_buffer)/sizeof(struct imp_packet)); i++) {
@@ -2706,7 +2862,7 @@ t_stat imp_attach(UNIT* uptr, CONST char* cptr)
     imp_data.dhcp_xid = (imp_data.mac[0] | (imp_data.mac[1] << 8) |
                         (imp_data.mac[2] << 16) | (imp_data.mac[3] << 24)) + (uint32)time(NULL);
     imp_data.dhcp_state = DHCP_STATE_OFF;
-    memset(imp_data.arp_table, 0, sizeof(imp_data.arp_table));
+    imp_arp_clear(&imp_data);
 
     /* If we're not doing DHCP and a gateway is defined on the network
        then define a static APR entry for the gateway to facilitate 
@@ -2753,6 +2909,7 @@ t_stat imp_detach(UNIT* uptr)
         uptr->flags &= ~UNIT_ATT;
         sim_cancel (uptr+1);                /* stop the packet timing services */
         sim_cancel (uptr+2);                /* stop the clock timer services */
+        imp_map_clear(&imp_data);
     }
     return SCPE_OK;
 }
@@ -215,6 +215,7 @@ t_stat cpu_set_hist (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_hist (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 t_stat cpu_set_serial (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_serial (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+t_stat cpu_show_resident (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 
 d10 adjsp (d10 val, a10 ea);
 void ibp (a10 ea, int32 pflgs);
@@ -404,6 +405,8 @@ MTAB cpu_mod[] = {
     { MTAB_XTD|MTAB_VDV|MTAB_NMO|MTAB_SHP, 0, "HISTORY", "HISTORY",
       &cpu_set_hist, &cpu_show_hist },
     { MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "SERIAL", "SERIAL", &cpu_set_serial, &cpu_show_serial },
+    { MTAB_XTD|MTAB_VDV, 0, "RESIDENT", NULL,
+      NULL, &cpu_show_resident, NULL, "Display host memory in use by simulated memory" },
     { 0 }
     };
 
@@ -2374,7 +2377,7 @@ set_dyn_ptrs ();
 set_ac_display (ac_cur);
 pi_eval ();
 if (M == NULL)
-    M = (d10 *) calloc (MAXMEMSIZE, sizeof (d10));
+    M = (d10 *) sim_mem_alloc (MAXMEMSIZE * sizeof (d10));
 if (M == NULL)
     return SCPE_MEM;
 sim_vm_pc_value = &pdp10_pc_value;
@@ -2604,3 +2607,15 @@ if( (apr_serial == -1) || (!Q_ITS && apr_serial < 4096) ) {
 fprintf (st, "%d", apr_serial);
 return SCPE_OK;
 }
+
+/* Host memory in use by simulated memory */
+
+t_stat cpu_show_resident (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+UNIT res = *uptr;
+
+res.capac = (t_addr) (sim_mem_resident (M, MAXMEMSIZE * sizeof (d10)) / sizeof (d10));
+fprintf (st, "%s resident", sprint_capac (&cpu_dev, &res));
+fprintf (st, " of %s configured", sprint_capac (&cpu_dev, uptr));
+return SCPE_OK;
+}
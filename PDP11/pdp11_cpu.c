@@ -334,6 +334,7 @@ int32 GeteaB (int32 spec);
 int32 GeteaW (int32 spec);
 int32 relocR (int32 addr);
 int32 relocW (int32 addr);
+int32 relocC (int32 addr, int32 sw);
 void relocR_test (int32 va, int32 apridx);
 void relocW_test (int32 va, int32 apridx);
 t_bool PLF_test (int32 va, int32 apr);
@@ -958,6 +959,7 @@ while (reason == 0)  {
     if (hst_lnt) {                                      /* record history? */
         t_value val;
         uint32 i;
+        int32 pa;
         static int32 swmap[4] = {
             SWMASK ('K') | SWMASK ('V'), SWMASK ('S') | SWMASK ('V'),
             SWMASK ('U') | SWMASK ('V'), SWMASK ('U') | SWMASK ('V')
@@ -969,10 +971,18 @@ while (reason == 0)  {
         hst_ent->src = 0;
         hst_ent->dst = 0;
         hst_ent->inst[0] = IR;
-        for (i = 1; i < HIST_ILNT; i++) {
-            if (cpu_ex (&val, (PC + (i << 1)) & 0177777, &cpu_unit, swmap[cm & 03]))
-                hst_ent->inst[i] = 0;
-            else hst_ent->inst[i] = (uint16) val;
+        pa = ((PC + 2) & 077) <= 072?                   /* rest in one block? */
+            relocC ((PC + 2) & 0177777, swmap[cm & 03]): MAXMEMSIZE;
+        if (ADDR_IS_MEM (pa) && ADDR_IS_MEM (pa + 4)) { /* yes, in memory */
+            for (i = 1; i < HIST_ILNT; i++)
+                hst_ent->inst[i] = (uint16) RdMemW (pa + ((i - 1) << 1));
+            }
+        else {
+            for (i = 1; i < HIST_ILNT; i++) {
+                if (cpu_ex (&val, (PC + (i << 1)) & 0177777, &cpu_unit, swmap[cm & 03]))
+                    hst_ent->inst[i] = 0;
+                else hst_ent->inst[i] = (uint16) val;
+                }
             }
         hst_p = (hst_p + 1);
         if (hst_p >= hst_lnt)
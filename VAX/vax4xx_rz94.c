@@ -728,9 +728,14 @@ switch (cmd & 0x7f) {
             case SCSI_MSGO:                             /* message out */
                 if (rz_bus.phase == 6)
                     scsi_release_atn (&rz_bus);
-                rz_buf[0] = 0;
-                for (; ((rz_bus.phase == old_phase) && (rz_txc > 0)); rz_txc--)
-                    scsi_write (&rz_bus, &rz_buf[0], 1);
+                while ((rz_bus.phase == old_phase) && (rz_txc > 0)) {
+                    txc = scsi_pending (&rz_bus);       /* pad whole phase */
+                    if ((txc == 0) || (txc > rz_txc))
+                        txc = (txc == 0) ? 1 : rz_txc;
+                    memset (&rz_buf[0], 0, txc);
+                    txc = scsi_write (&rz_bus, &rz_buf[0], txc);
+                    rz_txc -= (txc == 0) ? 1 : txc;     /* pad byte consumed */
+                    }
                 if (rz_txc == 0)
                     rz_stat |= STS_TC;
                 break;
@@ -738,8 +743,10 @@ switch (cmd & 0x7f) {
             case SCSI_DATI:                             /* data in */
             case SCSI_STS:                              /* status */
             case SCSI_MSGI:                             /* message in */
-                for (; ((rz_bus.phase == old_phase) && (rz_txc > 0)); rz_txc--)
-                    txc = scsi_read (&rz_bus, &rz_buf[0], 1);
+                while ((rz_bus.phase == old_phase) && (rz_txc > 0)) {
+                    txc = scsi_read (&rz_bus, &rz_buf[0], rz_txc);  /* discard whole phase */
+                    rz_txc -= (txc == 0) ? 1 : txc;     /* pad byte consumed */
+                    }
                 if (rz_txc == 0)
                     rz_stat |= STS_TC;
                 break;
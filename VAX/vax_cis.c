@@ -102,6 +102,8 @@ int32 i, j, c, t, pop, rpt, V;
 int32 match, fill, sign, shift;
 int32 ldivd, ldivr;
 int32 lenl, lenp;
+int32 soff, doff, lnt, k;
+uint8 *sp, *dp, *tp[2] = { NULL, NULL };
 uint32 nc, d, result;
 t_stat r;
 DSTR accum, src1, src2, dst;
@@ -184,6 +186,26 @@ switch (opc) {                                          /* case on opcode */
                 R[5] = (R[5] + mvl) & LMASK;
                 }
             else {                                      /* forward */
+                while (R[2]) {                          /* page spans */
+                    sp = MapStr (R[1], RA, &soff);      /* src, table, dst */
+                    if ((sp == NULL) ||                 /* in Read order */
+                        ((tp[STR_TBL_PG (R[3], sp[0])] == NULL) &&
+                         !MapStrTbl (R[3], sp[0], tp, RA)) ||
+                        ((dp = MapStr (R[5], WA, &doff)) == NULL))
+                        break;
+                    lnt = VA_PAGSIZE - ((soff > doff)? soff: doff);
+                    if (lnt > R[2])
+                        lnt = R[2];
+                    for (k = 0; k < lnt; k++) {         /* translate span */
+                        t = sp[k];
+                        if (tp[STR_TBL_PG (R[3], t)] == NULL)
+                            break;                      /* table page unmapped */
+                        dp[k] = STR_TBL (R[3], tp, t);
+                        }
+                    R[1] = (R[1] + k) & LMASK;          /* adv src, dst */
+                    R[2] = (R[2] - k) & STR_LNMASK;
+                    R[5] = (R[5] + k) & LMASK;
+                    }
                 while (R[2]) {                          /* loop thru char */
                     t = Read (R[1], L_BYTE, RA);        /* read src */
                     c = Read ((R[3] + t) & LMASK, L_BYTE, RA);
@@ -253,6 +275,35 @@ switch (opc) {                                          /* case on opcode */
             R[2] = cc;                                  /* save cc's */
             PSL = PSL | PSL_FPD;                        /* set FPD */
             }
+        while ((R[0] & STR_LNMASK) && R[4]) {           /* page spans */
+            sp = MapStr (R[1], RA, &soff);              /* src, table, dst */
+            if ((sp == NULL) ||                         /* in Read order */
+                ((tp[STR_TBL_PG (R[3], sp[0])] == NULL) &&
+                 !MapStrTbl (R[3], sp[0], tp, RA)) ||
+                ((dp = MapStr (R[5], WA, &doff)) == NULL))
+                break;
+            lnt = VA_PAGSIZE - ((soff > doff)? soff: doff);
+            if (lnt > (R[0] & STR_LNMASK))
+                lnt = R[0] & STR_LNMASK;
+            if (lnt > R[4])
+                lnt = R[4];
+            for (k = 0; k < lnt; k++) {                 /* translate span */
+                t = sp[k];
+                if (tp[STR_TBL_PG (R[3], t)] == NULL)
+                    break;                              /* table page unmapped */
+                c = STR_TBL (R[3], tp, t);
+                if (c == fill)                          /* stop char? */
+                    break;
+                dp[k] = (uint8) c;
+                }
+            R[0] = (R[0] & ~STR_LNMASK) | ((R[0] - k) & STR_LNMASK);
+            R[1] = (R[1] + k) & LMASK;
+            R[4] = (R[4] - k) & STR_LNMASK;             /* adv src, dst */
+            R[5] = (R[5] + k) & LMASK;
+            if ((k < lnt) &&                            /* stop char? */
+                (tp[STR_TBL_PG (R[3], sp[k])] != NULL))
+                break;                                  /* loop below sets V */
+            }
         while ((R[0] & STR_LNMASK) && R[4]) {           /* while src & dst */
             t = Read (R[1], L_BYTE, RA);                /* read src */
             c = Read ((R[3] + t) & LMASK, L_BYTE, RA);  /* translate */
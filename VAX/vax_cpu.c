@@ -273,12 +273,21 @@ int32 extra_bytes;                                      /* bytes referenced by c
 jmp_buf save_env;
 REG *pcq_r = NULL;                                      /* PC queue reg ptr */
 int32 pcq[PCQ_SIZE] = { 0 };                            /* PC queue */
-InstHistory *hst = NULL;                                /* instruction history */
-int32 hst_p = 0;                                        /* history pointer */
+uint32 *hst = NULL;                                     /* instruction history ring */
+uint32 hst_mask = 0;                                    /* ring size - 1 (longwords) */
+uint32 hst_p = 0;                                       /* next record */
+uint32 hst_old = 0;                                     /* oldest record */
+uint32 hst_used = 0;                                    /* longwords in use */
+uint32 hst_cnt = 0;                                     /* records in use */
+uint32 hst_res = 0;                                     /* last record's results */
+int32 hst_nres = 0;                                     /* number of results */
+InstHistory hst_last;                                   /* last record's results */
 int32 hst_lnt = 0;                                      /* history length */
 int32 hst_switches;                                     /* history option switches */
 FILE *hst_log;                                          /* history log file */
-int32 hst_log_p;                                        /* history last log written pointer */
+uint32 hst_log_p;                                       /* first record not logged */
+uint32 hst_log_used;                                    /* longwords not logged */
+uint32 hst_log_cnt;                                     /* records not logged */
 int32 step_out_nest_level = 0;                          /* step to call return - nest level */
 
 const uint32 byte_mask[33] = { 0x00000000,
@@ -317,6 +326,7 @@ t_stat cpu_set_size (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_set_hist (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_hist (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 t_stat cpu_show_virt (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+t_stat cpu_show_resident (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 t_stat cpu_set_idle (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_idle (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 t_stat cpu_set_instruction_set (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
@@ -326,7 +336,12 @@ int32 cpu_get_vsw (int32 sw);
 static SIM_INLINE int32 get_istr (int32 lnt, int32 acc);
 int32 ReadOcta (int32 va, int32 *opnd, int32 j, int32 acc);
 t_bool cpu_show_opnd (FILE *st, InstHistory *h, int32 line);
-t_stat cpu_show_hist_records (FILE *st, t_bool do_header, int32 start, int32 count);
+t_stat cpu_show_hist_records (FILE *st, t_bool do_header, uint32 start, uint32 count);
+void cpu_hist_record (int32 opc, int32 psl, int32 *opnd, int32 nopnd, int32 lim, int32 acc);
+uint32 cpu_hist_decode (const uint32 *ring, uint32 mask, uint32 p, InstHistory *h);
+void cpu_hist_flush_log (void);
+t_stat cpu_show_hist_file (FILE *st, const char *fname);
+void cpu_show_hist_entry (FILE *st, InstHistory *h);
 int32 cpu_emulate_exception (int32 *opnd, int32 cc, int32 opc, int32 acc);
 void cpu_idle (void);
 
@@ -427,6 +442,8 @@ MTAB cpu_mod[] = {
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE={VMS|ULTRIX|ULTRIX-1.X|ULTRIXOLD|NETBSD|NETBSDOLD|OPENBSD|OPENBSDOLD|QUASIJARUS|32V|ELN|MDM}{:n}", &cpu_set_idle, &cpu_show_idle, NULL, "Display idle detection mode" },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL, NULL,  "Disables idle detection" },
     MEM_MODIFIERS,   /* Model specific memory modifiers from vaxXXX_defs.h */
+    { MTAB_XTD|MTAB_VDV, 0, "RESIDENT", NULL,
+      NULL, &cpu_show_resident, NULL, "Display host memory in use by simulated memory" },
     { MTAB_XTD|MTAB_VDV|MTAB_NMO|MTAB_SHP|MTAB_NC, 0, "HISTORY", "HISTORY",
       &cpu_set_hist, &cpu_show_hist, NULL, "Displays instruction history" },
     { MTAB_XTD|MTAB_VDV|MTAB_NMO|MTAB_SHP, 0, "VIRTUAL", NULL,
@@ -515,10 +532,8 @@ abortval = setjmp (save_env);                           /* set abort hdlr */
 if (abortval > 0) {                                     /* sim stop? */
     PSL = PSL | cc;                                     /* put PSL together */
     pcq_r->qptr = pcq_p;                                /* update pc q ptr */
-    if (hst_log) {                                      /* auto logging history? */
-        cpu_show_hist_records (hst_log, FALSE, hst_log_p, (hst_p < hst_log_p) ? hst_lnt - (hst_log_p - hst_p) : hst_p - hst_log_p);
-        hst_log_p = hst_p;                              /* record everything logged */
-        }
+    if (hst_log)                                        /* auto logging history? */
+        cpu_hist_flush_log ();                          /* record everything logged */
     return abortval;                                    /* return to SCP */
     }
 else if (abortval < 0) {                                /* mm or rsrv or int */
@@ -605,8 +620,8 @@ for ( ;; ) {
 
 /* Optionally record instruction history results from prior instruction */
 
-    if (hst_lnt) {
-        InstHistory *hlast = &hst[hst_p ? hst_p-1 : hst_lnt -1];
+    if (hst_nres) {
+        InstHistory *hlast = &hst_last;
 
         switch (DR_GETRES(drom[hlast->opc][0]) << DR_V_RESMASK) {
             case RB_O:
@@ -641,6 +656,8 @@ for ( ;; ) {
             default:
                 break;
             }
+        for (i = 0; i < hst_nres; i++)
+            hst[(hst_res + i) & hst_mask] = hlast->res[i];
         }
 
     if (cpu_astop) {
@@ -1554,35 +1571,8 @@ for ( ;; ) {
 
 /* Optionally record instruction history */
 
-    if (hst_lnt) {
-        int32 lim;
-        t_value wd;
-        InstHistory *h = &hst[hst_p];
-
-        h->iPC = fault_PC;
-        h->PSL = PSL | cc;
-        h->opc = opc;
-        for (i = 0; i < j; i++)
-            h->opnd[i] = opnd[i];
-        lim = PC - fault_PC;
-        if ((uint32) lim > INST_SIZE)
-            lim = INST_SIZE;
-        for (i = 0; i < lim; i++) {
-            if ((cpu_ex (&wd, fault_PC + i, &cpu_unit, SWMASK ('V'))) == SCPE_OK)
-                h->inst[i] = (uint8) wd;
-            else {
-                h->inst[0] = h->inst[1] = 0xFF;
-                break;
-                }
-            }
-        if (hst_switches & SWMASK('T'))
-            h->time = sim_gtime();
-        hst_p = hst_p + 1;
-        if (hst_p >= hst_lnt)
-            hst_p = 0;
-        if (hst_log && (hst_p == hst_log_p))
-            cpu_show_hist_records (hst_log, FALSE, hst_log_p, hst_lnt);
-        }
+    if (hst_lnt)
+        cpu_hist_record (opc, PSL | cc, opnd, j, PC - fault_PC, acc);
 
 /* Dispatch to instructions */
 
@@ -3146,7 +3136,7 @@ for ( ;; ) {
     case MULH2: case MULH3: case DIVH2: case DIVH3:
     case ACBH: case POLYH: case EMODH:
         cc = op_octa (opnd, cc, opc, acc, spec, va, 
-                      (hst_lnt ? &hst[hst_p ? hst_p-1 : hst_lnt -1] : NULL) );
+                      (hst_lnt ? &hst_last : NULL) );
         if (cc & LSIGN) {                               /* ACBH branch? */
             BRANCHW (brdisp);
             cc = cc & CC_MASK;                          /* mask off flag */
@@ -3323,7 +3313,7 @@ if (M == NULL) {                        /* first time init? */
     if (pcq_r == NULL)
         return SCPE_IERR;
     pcq_r->qptr = 0;
-    M = (uint32 *) calloc (((uint32) MEMSIZE) >> 2, sizeof (uint32));
+    M = (uint32 *) sim_mem_alloc ((size_t) MEMSIZE);
     if (M == NULL)
         return SCPE_MEM;
     auto_config(NULL, 0);               /* do an initial auto configure */
@@ -3428,7 +3418,7 @@ return SCPE_NXM;
 t_stat cpu_set_size (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
 {
 int32 mc = 0;
-uint32 i, clim, uval = (uint32)val;
+uint32 i, uval = (uint32)val;
 uint32 *nM = NULL;
 
 if ((val <= 0) || (val > MAXMEMSIZE_X))
@@ -3437,19 +3427,27 @@ for (i = val; i < MEMSIZE; i = i + 4)
     mc = mc | M[i >> 2];
 if ((mc != 0) && !get_yn ("Really truncate memory [N]?", FALSE))
     return SCPE_OK;
-nM = (uint32 *) calloc (uval >> 2, sizeof (uint32));
+nM = (uint32 *) sim_mem_resize (M, (size_t) MEMSIZE, (size_t) uval);
 if (nM == NULL)
     return SCPE_MEM;
-clim = (uint32)((uval < MEMSIZE)? uval: MEMSIZE);
-for (i = 0; i < clim; i = i + 4)
-    nM[i >> 2] = M[i >> 2];
-free (M);
 M = nM;
 MEMSIZE = uval; 
 reset_all (0);
 return SCPE_OK;
 }
 
+/* Host memory in use by simulated memory */
+
+t_stat cpu_show_resident (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+UNIT res = *uptr;
+
+res.capac = (t_addr) sim_mem_resident (M, (size_t) MEMSIZE);
+fprintf (st, "%s resident", sprint_capac (&cpu_dev, &res));
+fprintf (st, " of %s configured", sprint_capac (&cpu_dev, uptr));
+return SCPE_OK;
+}
+
 /* Virtual address translation */
 
 t_stat cpu_show_virt (FILE *of, UNIT *uptr, int32 val, CONST void *desc)
@@ -3502,22 +3500,242 @@ else md = PSL_GETCUR (PSL);
 return ACC_MASK (md);
 }
 
+/* Instruction history
+
+   The history is a ring of longwords, a power of two in size, holding
+   variable length records:
+
+        header          opcode, operand count, instruction length,
+                        result count, flags, record length
+        iPC
+        PSL
+        instruction bytes, four per longword
+        operands, as decoded
+        results, stored when the next instruction starts
+        sim_time (a double), if enabled with -T
+
+   so a record costs only the operands and results its instruction has.
+   The oldest records are dropped to make room for each new one, after
+   first being written to the history log, if there is one.  A binary
+   log (-B) is a four longword file header followed by the records as
+   they are in the ring; SHOW CPU HISTORY=file decodes it.
+*/
+
+#define HST_V_OPC       0                               /* opcode */
+#define HST_M_OPC       0x1FF
+#define HST_V_NOP       9                               /* # operands */
+#define HST_M_NOP       0x1F
+#define HST_V_NIN       14                              /* # inst bytes */
+#define HST_M_NIN       0x3F
+#define HST_V_NRS       20                              /* # results */
+#define HST_M_NRS       0x7
+#define HST_TIME        (1u << 23)                      /* time recorded */
+#define HST_IBAD        (1u << 24)                      /* inst unreadable */
+#define HST_V_LNT       25                              /* record length */
+#define HST_M_LNT       0x7F
+#define HST_GET(h,f)    (((h) >> HST_V_##f) & HST_M_##f)
+#define HST_AVG         12                              /* est lw per record */
+#define HST_MAGIC       0x48584156                      /* binary log "VAXH" */
+#define HST_VERSION     1
+
+static const uint8 hst_res_lnt[16] = {                  /* results by DR_GETRES */
+    0, 1, 1, 1, 2, 4, 4, 4, 4, 4, 1, 2, 4, 6, 1, 0
+    };
+
+/* Record an instruction
+
+   Inputs:
+        opc     =       opcode
+        psl     =       PSL, including condition codes
+        opnd    =       decoded operands
+        nopnd   =       number of operands
+        lim     =       instruction length
+        acc     =       access mode of the instruction stream
+*/
+
+void cpu_hist_record (int32 opc, int32 psl, int32 *opnd, int32 nopnd, int32 lim, int32 acc)
+{
+uint32 ib[(INST_SIZE + 3) >> 2];
+uint32 ring_lnt = hst_mask + 1;
+uint32 hdr, p, lnt, l;
+int32 i, nw, nres, st, pa;
+t_value wd;
+
+if ((uint32) lim > INST_SIZE)
+    lim = INST_SIZE;
+nw = (lim + 3) >> 2;
+nres = hst_res_lnt[DR_GETRES (drom[opc][0])];
+lnt = 3 + nw + nopnd + nres;
+hdr = (opc << HST_V_OPC) | (nopnd << HST_V_NOP) |
+    (lim << HST_V_NIN) | (nres << HST_V_NRS);
+if (hst_switches & SWMASK ('T')) {
+    hdr = hdr | HST_TIME;
+    lnt = lnt + 2;
+    }
+hdr = hdr | (lnt << HST_V_LNT);
+if (hst_log && ((hst_log_used + lnt) > ring_lnt))       /* log before reuse */
+    cpu_hist_flush_log ();
+while ((hst_used + lnt) > ring_lnt) {                   /* drop oldest */
+    l = HST_GET (hst[hst_old], LNT);
+    hst_old = (hst_old + l) & hst_mask;
+    hst_used = hst_used - l;
+    hst_cnt = hst_cnt - 1;
+    }
+p = hst_p;
+hst[(p + 1) & hst_mask] = fault_PC;
+hst[(p + 2) & hst_mask] = psl;
+p = p + 3;
+if (nw) {                                               /* inst bytes */
+    memset (ib, 0, nw << 2);
+    pa = Test (fault_PC, acc, &st);
+    if ((st == PR_OK) && ADDR_IS_MEM (pa) && ADDR_IS_MEM (pa + lim - 1) &&
+        (!mapen || ((VA_GETOFF (fault_PC) + lim) <= VA_PAGSIZE))) {
+        for (i = 0; i < lim; i++, pa++)                 /* one page in memory */
+            ib[i >> 2] |= ((M[pa >> 2] >> ((pa & 3) << 3)) & BMASK) << ((i & 3) << 3);
+        }
+    else {
+        for (i = 0; i < lim; i++) {
+            if ((cpu_ex (&wd, fault_PC + i, &cpu_unit, SWMASK ('V'))) != SCPE_OK) {
+                hdr = hdr | HST_IBAD;
+                break;
+                }
+            ib[i >> 2] |= ((uint32) wd & BMASK) << ((i & 3) << 3);
+            }
+        }
+    for (i = 0; i < nw; i++)
+        hst[(p + i) & hst_mask] = ib[i];
+    p = p + nw;
+    }
+for (i = 0; i < nopnd; i++)                             /* operands */
+    hst[(p + i) & hst_mask] = opnd[i];
+p = p + nopnd;
+hst_res = p;                                            /* results, next inst */
+hst_nres = nres;
+hst_last.opc = opc;
+for (i = 0; i < nres; i++)
+    hst[(p + i) & hst_mask] = hst_last.res[i] = 0;
+p = p + nres;
+if (hdr & HST_TIME) {                                   /* sim_time */
+    double t = sim_gtime ();
+    uint32 tw[2];
+
+    memcpy (tw, &t, sizeof (tw));
+    hst[p & hst_mask] = tw[0];
+    hst[(p + 1) & hst_mask] = tw[1];
+    }
+hst[hst_p] = hdr;
+hst_p = (hst_p + lnt) & hst_mask;
+hst_used = hst_used + lnt;
+hst_cnt = hst_cnt + 1;
+if (hst_log) {
+    hst_log_used = hst_log_used + lnt;
+    hst_log_cnt = hst_log_cnt + 1;
+    }
+return;
+}
+
+/* Decode the history record at p into an InstHistory, return its length */
+
+uint32 cpu_hist_decode (const uint32 *ring, uint32 mask, uint32 p, InstHistory *h)
+{
+uint32 hdr = ring[p & mask];
+uint32 i, nin, nop, nres;
+
+nin = HST_GET (hdr, NIN);
+nop = HST_GET (hdr, NOP);
+nres = HST_GET (hdr, NRS);
+memset (h, 0, sizeof (*h));
+h->opc = HST_GET (hdr, OPC);
+h->iPC = ring[(p + 1) & mask];
+h->PSL = ring[(p + 2) & mask];
+p = p + 3;
+for (i = 0; i < nin; i++)
+    h->inst[i] = (uint8) (ring[(p + (i >> 2)) & mask] >> ((i & 3) << 3));
+if (hdr & HST_IBAD)
+    h->inst[0] = h->inst[1] = 0xFF;
+p = p + ((nin + 3) >> 2);
+for (i = 0; i < nop; i++)
+    h->opnd[i] = ring[(p + i) & mask];
+p = p + nop;
+for (i = 0; i < nres; i++)
+    h->res[i] = ring[(p + i) & mask];
+p = p + nres;
+if (hdr & HST_TIME) {
+    uint32 tw[2];
+
+    tw[0] = ring[p & mask];
+    tw[1] = ring[(p + 1) & mask];
+    memcpy (&h->time, tw, sizeof (tw));
+    }
+return HST_GET (hdr, LNT);
+}
+
+/* Write the records not yet logged to the history log */
+
+void cpu_hist_flush_log (void)
+{
+uint32 p = hst_log_p;
+uint32 n = hst_log_used;
+uint32 c;
+
+if (hst_log_cnt) {
+    if (hst_switches & SWMASK ('B')) {                  /* binary? */
+        while (n) {                                     /* copy out, to wrap */
+            c = hst_mask + 1 - p;
+            if (c > n)
+                c = n;
+            fwrite (hst + p, sizeof (*hst), c, hst_log);
+            p = (p + c) & hst_mask;
+            n = n - c;
+            }
+        fflush (hst_log);
+        }
+    else cpu_show_hist_records (hst_log, FALSE, hst_log_p, hst_log_cnt);
+    }
+hst_log_p = hst_p;
+hst_log_used = 0;
+hst_log_cnt = 0;
+}
+
+static void cpu_show_hist_header (FILE *st)
+{
+if (hst_switches & SWMASK('T'))
+    fprintf (st," TIME       ");
+fprintf (st, "PC       PSL       IR\n\n");
+}
+
+static void cpu_hist_log_header (void)
+{
+uint32 fhdr[4];
+
+if (hst_switches & SWMASK ('B')) {
+    fhdr[0] = HST_MAGIC;
+    fhdr[1] = HST_VERSION;
+    fhdr[2] = (uint32) hst_switches;
+    fhdr[3] = 0;
+    fwrite (fhdr, sizeof (*fhdr), 4, hst_log);
+    fflush (hst_log);
+    }
+else cpu_show_hist_header (hst_log);
+}
+
 /* Set history */
 
 t_stat cpu_set_hist (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
 {
-int32 i, lnt;
+int32 lnt;
+uint32 ring_lnt;
 char gbuf[CBUFSIZE];
 t_stat r;
 
 if (cptr == NULL) {
-    for (i = 0; i < hst_lnt; i++)
-        hst[i].iPC = 0;
-    hst_p = 0;
+    hst_p = hst_old = hst_used = hst_cnt = 0;
+    hst_nres = 0;
     if (hst_log) {
         sim_set_fsize (hst_log, (t_addr)0);
-        hst_log_p = 0;
-        cpu_show_hist_records (hst_log, TRUE, 0, 0);
+        rewind (hst_log);
+        hst_log_p = hst_log_used = hst_log_cnt = 0;
+        cpu_hist_log_header ();
         }
     return SCPE_OK;
     }
@@ -3527,30 +3745,36 @@ if (r != SCPE_OK)
     return sim_messagef (SCPE_ARG, "Invalid Numeric Value: %s\n", gbuf);
 if (lnt && (lnt < HIST_MIN))
     return sim_messagef (SCPE_ARG, "%d is less than the minumum history value of %d\n", lnt, HIST_MIN);
-hst_p = 0;
+hst_p = hst_old = hst_used = hst_cnt = 0;
+hst_nres = 0;
+hst_log_p = hst_log_used = hst_log_cnt = 0;
 if (hst_lnt) {
     free (hst);
     hst_lnt = 0;
     hst = NULL;
+    hst_mask = 0;
     if (hst_log) {
         fclose (hst_log);
         hst_log = NULL;
         }
     }
 if (lnt) {
-    hst = (InstHistory *) calloc (lnt, sizeof (InstHistory));
+    for (ring_lnt = 1; ring_lnt < ((uint32) lnt * HST_AVG); ring_lnt = ring_lnt << 1) ;
+    hst = (uint32 *) calloc (ring_lnt, sizeof (uint32));
     if (hst == NULL)
             return SCPE_MEM;
+    hst_mask = ring_lnt - 1;
     hst_lnt = lnt;
     hst_switches = sim_switches;
     if (cptr && *cptr) {
-        hst_log = sim_fopen (cptr, "w");
+        hst_log = sim_fopen (cptr, (hst_switches & SWMASK ('B'))? "wb": "w");
         if (hst_log)
-            cpu_show_hist_records (hst_log, TRUE, 0, 0);
+            cpu_hist_log_header ();
         else {
             free (hst);
             hst_lnt = 0;
             hst = NULL;
+            hst_mask = 0;
             return sim_messagef(SCPE_OPENERR, "Unable to open file '%s': %s\n", cptr, strerror (errno));
             }            
         }
@@ -3562,67 +3786,106 @@ return SCPE_OK;
 
 t_stat cpu_show_hist (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
 {
-int32 di, lnt;
+uint32 k, di, lnt;
 const char *cptr = (const char *) desc;
 t_stat r;
 
+if (cptr && !isdigit ((unsigned char) *cptr))           /* binary log file? */
+    return cpu_show_hist_file (st, cptr);
 if (hst_lnt == 0)                                       /* enabled? */
     return SCPE_NOFNC;
 if (cptr) {
-    lnt = (int32) get_uint (cptr, 10, hst_lnt, &r);
+    lnt = (uint32) get_uint (cptr, 10, 0x7FFFFFFF, &r);
     if ((r != SCPE_OK) || (lnt == 0))
         return SCPE_ARG;
+    if (lnt > hst_cnt)
+        lnt = hst_cnt;
     }
-else lnt = hst_lnt;
-di = hst_p - lnt;                                       /* work forward */
-if (di < 0)
-    di = di + hst_lnt;
+else lnt = hst_cnt;
+di = hst_old;                                           /* work forward */
+for (k = lnt; k < hst_cnt; k++)                         /* to last lnt */
+    di = (di + HST_GET (hst[di], LNT)) & hst_mask;
 return cpu_show_hist_records (st, TRUE, di, lnt);
 }
 
-t_stat cpu_show_hist_records (FILE *st, t_bool do_header, int32 start, int32 count)
+/* Decode a binary history log */
+
+t_stat cpu_show_hist_file (FILE *st, const char *fname)
+{
+uint32 rec[HST_M_LNT + 1];
+uint32 lnt;
+int32 sw = hst_switches;
+InstHistory h;
+FILE *f;
+
+f = sim_fopen (fname, "rb");
+if (f == NULL)
+    return sim_messagef (SCPE_OPENERR, "Unable to open file '%s': %s\n", fname, strerror (errno));
+if ((fread (rec, sizeof (*rec), 4, f) != 4) ||
+    (rec[0] != HST_MAGIC) || (rec[1] != HST_VERSION)) {
+    fclose (f);
+    return sim_messagef (SCPE_FMT, "'%s' is not a binary instruction history log\n", fname);
+    }
+hst_switches = (int32) rec[2];                          /* display as recorded */
+cpu_show_hist_header (st);
+while (fread (rec, sizeof (*rec), 1, f) == 1) {
+    lnt = HST_GET (rec[0], LNT);
+    if ((lnt < 3) ||
+        (fread (rec + 1, sizeof (*rec), lnt - 1, f) != (lnt - 1)))
+        break;
+    cpu_hist_decode (rec, HST_M_LNT, 0, &h);
+    cpu_show_hist_entry (st, &h);
+    }
+hst_switches = sw;
+fclose (f);
+return SCPE_OK;
+}
+
+t_stat cpu_show_hist_records (FILE *st, t_bool do_header, uint32 start, uint32 count)
 {
-int32 i, k, numspec;
-InstHistory *h;
+uint32 k;
+InstHistory h;
 
 if (hst_lnt == 0)                                       /* enabled? */
     return SCPE_NOFNC;
-if (do_header) {
-    if (hst_switches & SWMASK('T'))
-        fprintf (st," TIME       ");
-    fprintf (st, "PC       PSL       IR\n\n");
-    }
+if (do_header)
+    cpu_show_hist_header (st);
 for (k = 0; k < count; k++) {                           /* print specified */
-    h = &hst[(start++) % hst_lnt];                      /* entry pointer */
-    if (h->iPC == 0)                                    /* filled in? */
-        continue;
-    if (hst_switches & SWMASK('T'))                     /* sim_time */
-        fprintf(st, "%10.0f  ", h->time);
-    fprintf(st, "%08X %08X| ", h->iPC, h->PSL);         /* PC, PSL */
-    numspec = DR_GETNSP (drom[h->opc][0]);              /* #specifiers */
-    if (opcode[h->opc] == NULL)                         /* undefined? */
+    start = (start + cpu_hist_decode (hst, hst_mask, start, &h)) & hst_mask;
+    cpu_show_hist_entry (st, &h);
+    }
+fflush (st);
+return SCPE_OK;
+}
+
+void cpu_show_hist_entry (FILE *st, InstHistory *h)
+{
+int32 i, numspec;
+
+if (hst_switches & SWMASK('T'))                         /* sim_time */
+    fprintf(st, "%10.0f  ", h->time);
+fprintf(st, "%08X %08X| ", h->iPC, h->PSL);             /* PC, PSL */
+numspec = DR_GETNSP (drom[h->opc][0]);                  /* #specifiers */
+if (opcode[h->opc] == NULL)                             /* undefined? */
+    fprintf (st, "%03X (undefined)", h->opc);
+else if (h->PSL & PSL_FPD)                              /* FPD set? */
+    fprintf (st, "%s FPD set", opcode[h->opc]);
+else {                                                  /* normal */
+    for (i = 0; i < INST_SIZE; i++)
+        sim_eval[i] = h->inst[i];
+    if ((fprint_sym (st, h->iPC, sim_eval, &cpu_unit, SWMASK ('M'))) > 0)
         fprintf (st, "%03X (undefined)", h->opc);
-    else if (h->PSL & PSL_FPD)                          /* FPD set? */
-        fprintf (st, "%s FPD set", opcode[h->opc]);
-    else {                                              /* normal */
-        for (i = 0; i < INST_SIZE; i++)
-            sim_eval[i] = h->inst[i];
-        if ((fprint_sym (st, h->iPC, sim_eval, &cpu_unit, SWMASK ('M'))) > 0)
-            fprintf (st, "%03X (undefined)", h->opc);
-        if ((numspec > 1) ||
-            ((numspec == 1) && (drom[h->opc][1] < BB))) {
-            if (cpu_show_opnd (st, h, 0)) {             /* operands; more? */
-                if (cpu_show_opnd (st, h, 1)) {         /* 2nd line; more? */
-                    cpu_show_opnd (st, h, 2);           /* octa, 3rd/4th */
-                    cpu_show_opnd (st, h, 3);
-                    }
+    if ((numspec > 1) ||
+        ((numspec == 1) && (drom[h->opc][1] < BB))) {
+        if (cpu_show_opnd (st, h, 0)) {                 /* operands; more? */
+            if (cpu_show_opnd (st, h, 1)) {             /* 2nd line; more? */
+                cpu_show_opnd (st, h, 2);               /* octa, 3rd/4th */
+                cpu_show_opnd (st, h, 3);
                 }
             }
-        }                                               /* end else */
-    fputc ('\n', st);                                   /* end line */
-    }                                                   /* end for */
-fflush (st);
-return SCPE_OK;
+        }
+    }                                                   /* end else */
+fputc ('\n', st);                                       /* end line */
 }
 
 t_bool cpu_show_opnd (FILE *st, InstHistory *h, int32 line)
@@ -3979,14 +4242,19 @@ fprintf (st, "The CPU can maintain a history of the most recently executed instr
 fprintf (st, "This is controlled by the SET CPU HISTORY and SHOW CPU HISTORY commands:\n\n");
 fprintf (st, "   sim> SET CPU HISTORY                 clear history buffer\n");
 fprintf (st, "   sim> SET CPU HISTORY=0               disable history\n");
-fprintf (st, "   sim> SET CPU {-T} HISTORY=n{:file}   enable history, length = n\n");
+fprintf (st, "   sim> SET CPU {-T}{-B} HISTORY=n{:file}  enable history, length = n\n");
 fprintf (st, "   sim> SHOW CPU HISTORY                print CPU history\n");
-fprintf (st, "   sim> SHOW CPU HISTORY=n              print first n entries of CPU history\n\n");
+fprintf (st, "   sim> SHOW CPU HISTORY=n              print last n entries of CPU history\n");
+fprintf (st, "   sim> SHOW CPU HISTORY=file           print a binary history log\n\n");
 fprintf (st, "The -T switch causes simulator time to be recorded (and displayed)\n");
 fprintf (st, "with each history entry.\n");
+fprintf (st, "History entries vary in size with the instruction's operands; the buffer\n");
+fprintf (st, "holds about 'n' entries, more for simple instructions.\n");
 fprintf (st, "When writing history to a file (SET CPU HISTORY=n:file), 'n' specifies\n");
-fprintf (st, "the buffer flush frequency.  Warning: prodigious amounts of disk space\n");
-fprintf (st, "may be comsumed.  The maximum length for the history is %d entries.\n\n", HIST_MAX);
+fprintf (st, "the buffer flush frequency.  The -B switch writes the file in a compact\n");
+fprintf (st, "binary form, which SHOW CPU HISTORY=file displays.  Warning: prodigious\n");
+fprintf (st, "amounts of disk space may be comsumed.  The maximum length for the\n");
+fprintf (st, "history is %d entries.\n\n", HIST_MAX);
 fprintf (st, "Different VAX systems implemented different VAX architecture instructions\n");
 fprintf (st, "in hardware with other instructions possibly emulated by software in the\n");
 fprintf (st, "system.  The instructions that a particular simulator implements can be\n");
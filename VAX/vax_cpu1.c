@@ -478,6 +478,18 @@ if (mask & 0x4000)                                      /* if pop SP, no inc */
 return;
 }
 
+/* Queue header and entry access
+
+   Each header or entry longword is translated once, with MapQue, where
+   the instruction first references it, and is then read and written
+   through the returned pointer.  If MapQue returns NULL (unaligned or
+   not in memory), the access falls back to Read and Write.
+*/
+
+#define QUE_RD(p,i,va,acc)  (((p) != NULL)? (p)[i]: Read ((va) + ((i) << 2), L_LONG, acc))
+#define QUE_WR(p,i,va,val)  (((p) != NULL)? (void) ((p)[i] = (val)): \
+                                Write ((va) + ((i) << 2), (val), L_LONG, WA))
+
 /* INSQUE
 
         opnd[0] =       entry address (ent.ab)
@@ -508,14 +520,18 @@ int32 op_insque (int32 *opnd, int32 acc)
 int32 p = opnd[1];
 int32 e = opnd[0];
 int32 s, cc;
-
-s = Read (p, L_LONG, WA);                               /* s <- (p), wchk */
-Read (s + 4, L_LONG, WA);                               /* wchk s+4 */
-Read (e + 4, L_LONG, WA);                               /* wchk e+4 */
+int32 *pp, *sp, *ep;
+
+pp = MapQue (p, WA);
+s = QUE_RD (pp, 0, p, WA);                              /* s <- (p), wchk */
+sp = MapQue (s + 4, WA);
+QUE_RD (sp, 0, s + 4, WA);                              /* wchk s+4 */
+ep = MapQue (e + 4, WA);
+QUE_RD (ep, 0, e + 4, WA);                              /* wchk e+4 */
 Write (e, s, L_LONG, WA);                               /* (e) <- s */
-Write (e + 4, p, L_LONG, WA);                           /* (e+4) <- p */
-Write (s + 4, e, L_LONG, WA);                           /* (s+4) <- ent */
-Write (p, e, L_LONG, WA);                               /* (p) <- e */
+QUE_WR (ep, 0, e + 4, p);                               /* (e+4) <- p */
+QUE_WR (sp, 0, s + 4, e);                               /* (s+4) <- ent */
+QUE_WR (pp, 0, p, e);                                   /* (p) <- e */
 CC_CMP_L (s, p);                                        /* set cc's */
 return cc;
 }
@@ -547,16 +563,18 @@ int32 op_remque (int32 *opnd, int32 acc)
 {
 int32 e = opnd[0];
 int32 s, p, cc;
+int32 *sp;
 
 s = Read (e, L_LONG, RA);                               /* s <- (e) */
 p = Read (e + 4, L_LONG, RA);                           /* p <- (e+4) */
 CC_CMP_L (s, p);                                        /* set cc's */
 if (e != p) {                                           /* queue !empty? */
-    Read (s + 4, L_LONG, WA);                           /* wchk (s+4) */
+    sp = MapQue (s + 4, WA);
+    QUE_RD (sp, 0, s + 4, WA);                          /* wchk (s+4) */
     if (opnd[1] == OP_MEM)                              /* wchk dest */
         Read (opnd[2], L_LONG, WA);
     Write (p, s, L_LONG, WA);                           /* (p) <- s */
-    Write (s + 4, p, L_LONG, WA);                       /* (s+4) <- p */
+    QUE_WR (sp, 0, s + 4, p);                           /* (s+4) <- p */
     }
 else cc = cc | CC_V;                                    /* else set v */
 if (opnd[1] != OP_MEM)                                  /* store result */
@@ -601,23 +619,28 @@ int32 h = opnd[1];
 int32 d = opnd[0];
 int32 a;
 int32 t;
+int32 *hp, *dp, *ap;
 
 if ((h == d) || ((h | d) & 07))                         /* h, d quad align? */
     RSVD_OPND_FAULT(op_insqhi);
-Read (d, L_BYTE, WA);                                   /* wchk ent */
-a = Read (h, L_LONG, WA);                               /* a <- (h), wchk */
+dp = MapQue (d, WA);
+if (dp == NULL)
+    Read (d, L_BYTE, WA);                               /* wchk ent */
+hp = MapQue (h, WA);
+a = QUE_RD (hp, 0, h, WA);                              /* a <- (h), wchk */
 if (a & 06)                                             /* chk quad align */
     RSVD_OPND_FAULT(op_insqhi);
 if (a & 01)                                             /* busy, cc = 0001 */
     return CC_C;
-Write (h, a | 1, L_LONG, WA);                           /* get interlock */
+QUE_WR (hp, 0, h, a | 1);                               /* get interlock */
 a = a + h;                                              /* abs addr of a */
 if (Test (a, WA, &t) < 0)                               /* wtst a, rls if err */
-    Write (h, a - h, L_LONG, WA);
-Write (a + 4, d - a, L_LONG, WA);                       /* (a+4) <- d-a, flt ok */
-Write (d, a - d, L_LONG, WA);                           /* (d) <- a-d */
-Write (d + 4, h - d, L_LONG, WA);                       /* (d+4) <- h-d */
-Write (h, d - h, L_LONG, WA);                           /* (h) <- d-h, rls int */
+    QUE_WR (hp, 0, h, a - h);
+ap = MapQue (a + 4, WA);
+QUE_WR (ap, 0, a + 4, d - a);                           /* (a+4) <- d-a, flt ok */
+QUE_WR (dp, 0, d, a - d);                               /* (d) <- a-d */
+QUE_WR (dp, 1, d, h - d);                               /* (d+4) <- h-d */
+QUE_WR (hp, 0, h, d - h);                               /* (h) <- d-h, rls int */
 return (a == h)? CC_Z: 0;                               /* Z = 1 if a = h */
 }
 
@@ -627,30 +650,35 @@ int32 h = opnd[1];
 int32 d = opnd[0];
 int32 a, c;
 int32 t;
+int32 *hp, *dp, *cp;
 
 if ((h == d) || ((h | d) & 07))                         /* h, d quad align? */
     RSVD_OPND_FAULT(op_insqti);
-Read (d, L_BYTE, WA);                                   /* wchk ent */
-a = Read (h, L_LONG, WA);                               /* a <- (h), wchk */
+dp = MapQue (d, WA);
+if (dp == NULL)
+    Read (d, L_BYTE, WA);                               /* wchk ent */
+hp = MapQue (h, WA);
+a = QUE_RD (hp, 0, h, WA);                              /* a <- (h), wchk */
 if (a == 0)                                             /* if empty, ins hd */
     return op_insqhi (opnd, acc);
 if (a & 06)                                             /* chk quad align */
     RSVD_OPND_FAULT(op_insqti);
 if (a & 01)                                             /* busy, cc = 0001 */
     return CC_C;
-Write (h, a | 1, L_LONG, WA);                           /* acquire interlock */
-c = Read (h + 4, L_LONG, RA) + h;                       /* c <- (h+4) + h */
+QUE_WR (hp, 0, h, a | 1);                               /* acquire interlock */
+c = QUE_RD (hp, 1, h, RA) + h;                          /* c <- (h+4) + h */
 if (c & 07) {                                           /* c quad aligned? */
-    Write (h, a, L_LONG, WA);                           /* release interlock */
+    QUE_WR (hp, 0, h, a);                               /* release interlock */
     RSVD_OPND_FAULT(op_insqti);                         /* fault */
     }
 if (Test (c, WA, &t) < 0)                               /* wtst c, rls if err */
-    Write (h, a, L_LONG, WA);
-Write (c, d - c, L_LONG, WA);                           /* (c) <- d-c, flt ok */
-Write (d, h - d, L_LONG, WA);                           /* (d) <- h-d */
-Write (d + 4, c - d, L_LONG, WA);                       /* (d+4) <- c-d */
-Write (h + 4, d - h, L_LONG, WA);                       /* (h+4) <- d-h */
-Write (h, a, L_LONG, WA);                               /* release interlock */
+    QUE_WR (hp, 0, h, a);
+cp = MapQue (c, WA);
+QUE_WR (cp, 0, c, d - c);                               /* (c) <- d-c, flt ok */
+QUE_WR (dp, 0, d, h - d);                               /* (d) <- h-d */
+QUE_WR (dp, 1, d, c - d);                               /* (d+4) <- c-d */
+QUE_WR (hp, 1, h, d - h);                               /* (h+4) <- d-h */
+QUE_WR (hp, 0, h, a);                                   /* release interlock */
 return 0;                                               /* q >= 2 entries */
 }
 
@@ -685,6 +713,7 @@ int32 op_remqhi (int32 *opnd, int32 acc)
 int32 h = opnd[0];
 int32 ar, a, b;
 int32 t;
+int32 *hp, *bp;
 
 if (h & 07)                                             /* h quad aligned? */
     RSVD_OPND_FAULT(op_remqhi);
@@ -693,25 +722,27 @@ if (opnd[1] == OP_MEM) {                                /* mem destination? */
         RSVD_OPND_FAULT(op_remqhi);
     Read (opnd[2], L_LONG, WA);                         /* wchk dst */
     }
-ar = Read (h, L_LONG, WA);                              /* ar <- (h) */
+hp = MapQue (h, WA);
+ar = QUE_RD (hp, 0, h, WA);                             /* ar <- (h) */
 if (ar & 06)                                            /* a quad aligned? */
     RSVD_OPND_FAULT(op_remqhi);
 if (ar & 01)                                            /* busy, cc = 0011 */
     return CC_V | CC_C;
 a = ar + h;                                             /* abs addr of a */
 if (ar) {                                               /* queue not empty? */
-    Write (h, ar | 1, L_LONG, WA);                      /* acquire interlock */
+    QUE_WR (hp, 0, h, ar | 1);                          /* acquire interlock */
     if (Test (a, RA, &t) < 0)                           /* read tst a */
-         Write (h, ar, L_LONG, WA);                     /* release if error */
+         QUE_WR (hp, 0, h, ar);                         /* release if error */
     b = Read (a, L_LONG, RA) + a;                       /* b <- (a)+a, flt ok */
     if (b & 07) {                                       /* b quad aligned? */
-        Write (h, ar, L_LONG, WA);                      /* release interlock */
+        QUE_WR (hp, 0, h, ar);                          /* release interlock */
         RSVD_OPND_FAULT(op_remqhi);                                /* fault */
         }
     if (Test (b, WA, &t) < 0)                           /* write test b */
-        Write (h, ar, L_LONG, WA);                      /* release if err */
-    Write (b + 4, h - b, L_LONG, WA);                   /* (b+4) <- h-b, flt ok */
-    Write (h, b - h, L_LONG, WA);                       /* (h) <- b-h, rls int */
+        QUE_WR (hp, 0, h, ar);                          /* release if err */
+    bp = MapQue (b + 4, WA);
+    QUE_WR (bp, 0, b + 4, h - b);                       /* (b+4) <- h-b, flt ok */
+    QUE_WR (hp, 0, h, b - h);                           /* (h) <- b-h, rls int */
     }
 if (opnd[1] != OP_MEM)                                  /* store result */
     R[opnd[1]] = a;
@@ -726,6 +757,7 @@ int32 op_remqti (int32 *opnd, int32 acc)
 int32 h = opnd[0];
 int32 ar, b, c;
 int32 t;
+int32 *hp, *bp;
 
 if (h & 07)                                             /* h quad aligned? */
     RSVD_OPND_FAULT(op_remqti);
@@ -734,35 +766,37 @@ if (opnd[1] == OP_MEM) {                                /* mem destination? */
         RSVD_OPND_FAULT(op_remqti);
     Read (opnd[2], L_LONG, WA);                         /* wchk dst */
     }
-ar = Read (h, L_LONG, WA);                              /* a <- (h) */
+hp = MapQue (h, WA);
+ar = QUE_RD (hp, 0, h, WA);                             /* a <- (h) */
 if (ar & 06)                                            /* a quad aligned? */
     RSVD_OPND_FAULT(op_remqti);
 if (ar & 01)                                            /* busy, cc = 0011 */
     return CC_V | CC_C;
 if (ar) {                                               /* queue not empty */
-    Write (h, ar | 1, L_LONG, WA);                      /* acquire interlock */
-    c = Read (h + 4, L_LONG, RA);                       /* c <- (h+4) */
+    QUE_WR (hp, 0, h, ar | 1);                          /* acquire interlock */
+    c = QUE_RD (hp, 1, h, RA);                          /* c <- (h+4) */
     if (ar == c) {                                      /* single entry? */
-        Write (h, ar, L_LONG, WA);                      /* release interlock */
+        QUE_WR (hp, 0, h, ar);                          /* release interlock */
         return op_remqhi (opnd, acc);                   /* treat as remqhi */
         }
     if (c & 07) {                                       /* c quad aligned? */
-        Write (h, ar, L_LONG, WA);                      /* release interlock */
+        QUE_WR (hp, 0, h, ar);                          /* release interlock */
         RSVD_OPND_FAULT(op_remqti);                                /* fault */
         }
     c = c + h;                                          /* abs addr of c */
     if (Test (c + 4, RA, &t) < 0)                       /* read test c+4 */
-        Write (h, ar, L_LONG, WA);                      /* release if error */
+        QUE_WR (hp, 0, h, ar);                          /* release if error */
     b = Read (c + 4, L_LONG, RA) + c;                   /* b <- (c+4)+c, flt ok */
     if (b & 07) {                                       /* b quad aligned? */
-        Write (h, ar, L_LONG, WA);                      /* release interlock */
+        QUE_WR (hp, 0, h, ar);                          /* release interlock */
         RSVD_OPND_FAULT(op_remqti);                                /* fault */
         }
     if (Test (b, WA, &t) < 0)                           /* write test b */
-        Write (h, ar, L_LONG, WA);                      /* release if error */
-    Write (b, h - b, L_LONG, WA);                       /* (b) <- h-b */
-    Write (h + 4, b - h, L_LONG, WA);                   /* (h+4) <- b-h */
-    Write (h, ar, L_LONG, WA);                          /* release interlock */
+        QUE_WR (hp, 0, h, ar);                          /* release if err */
+    bp = MapQue (b, WA);
+    QUE_WR (bp, 0, b, h - b);                           /* (b) <- h-b */
+    QUE_WR (hp, 1, h, b - h);                           /* (h+4) <- b-h */
+    QUE_WR (hp, 0, h, ar);                              /* release interlock */
     }
 else c = h;                                             /* empty, result = h */
 if (opnd[1] != OP_MEM)                                  /* store result */
@@ -802,12 +836,19 @@ return 0;                                               /* q can't be empty */
         R3      =       current dest address
         R4      =       dstlen - srclen (loop count if fill state)
         R5      =       cc/state
+
+   When the strings are in memory, MapStr is used to move (and fill) a
+   page contiguous span at a time with memmove (memset), updating the
+   registers at each source or destination page boundary.  Whatever
+   remains (I/O space, big endian host) uses the byte/longword loops.
 */
 
 int32 op_movc (int32 *opnd, int32 movc5, int32 acc)
 {
 int32 i, cc, fill, wd;
 int32 j, lnt, mlnt[3];
+int32 soff, doff;
+uint8 *sp, *dp;
 static const int32 looplnt[3] = { L_BYTE, L_LONG, L_BYTE };
 
 if (PSL & PSL_FPD) {                                    /* FPD set? */
@@ -859,6 +900,20 @@ else {
 switch (R[5] & MVC_M_STATE) {                           /* case on state */
 
     case MVC_FRWD:                                      /* move forward */
+        while (R[2] > 0) {                              /* page spans */
+            sp = MapStr (R[1], RA, &soff);
+            dp = MapStr (R[3], WA, &doff);
+            if ((sp == NULL) || (dp == NULL))
+                break;
+            lnt = VA_PAGSIZE - ((soff > doff)? soff: doff); /* to nearer page end */
+            if (lnt > R[2])
+                lnt = R[2];
+            memmove (dp, sp, lnt);
+            R[1] = R[1] + lnt;                          /* inc src addr */
+            R[3] = R[3] + lnt;                          /* inc dst addr */
+            R[2] = R[2] - lnt;                          /* dec move lnt */
+            extra_bytes = extra_bytes + ((lnt + 3) >> 2);
+            }
         mlnt[0] = (4 - R[3]) & 3;                       /* length to align */
         if (mlnt[0] > R[2])                             /* cant exceed total */
             mlnt[0] = R[2];
@@ -877,6 +932,20 @@ switch (R[5] & MVC_M_STATE) {                           /* case on state */
         goto FILL;                                      /* check for fill */
 
     case MVC_BACK:                                      /* move backward */
+        while (R[2] > 0) {                              /* page spans */
+            sp = MapStr (R[1] - 1, RA, &soff);
+            dp = MapStr (R[3] - 1, WA, &doff);
+            if ((sp == NULL) || (dp == NULL))
+                break;
+            lnt = ((soff < doff)? soff: doff) + 1;      /* to nearer page start */
+            if (lnt > R[2])
+                lnt = R[2];
+            memmove (dp + 1 - lnt, sp + 1 - lnt, lnt);
+            R[1] = R[1] - lnt;                          /* dec src addr */
+            R[3] = R[3] - lnt;                          /* dec dst addr */
+            R[2] = R[2] - lnt;                          /* dec move lnt */
+            extra_bytes = extra_bytes + ((lnt + 3) >> 2);
+            }
         mlnt[0] = R[3] & 03;                            /* length to align */
         if (mlnt[0] > R[2])                             /* cant exceed total */
             mlnt[0] = R[2];
@@ -900,6 +969,18 @@ switch (R[5] & MVC_M_STATE) {                           /* case on state */
         if (R[4] <= 0)                                  /* any fill? */
             break;
         R[5] = R[5] | MVC_FILL;                         /* set state */
+        while (R[4] > 0) {                              /* page spans */
+            dp = MapStr (R[3], WA, &doff);
+            if (dp == NULL)
+                break;
+            lnt = VA_PAGSIZE - doff;                    /* to page end */
+            if (lnt > R[4])
+                lnt = R[4];
+            memset (dp, fill & BMASK, lnt);
+            R[3] = R[3] + lnt;                          /* inc dst addr */
+            R[4] = R[4] - lnt;                          /* dec fill lnt */
+            extra_bytes = extra_bytes + ((lnt + 3) >> 2);
+            }
         mlnt[0] = (4 - R[3]) & 3;                       /* length to align */
         if (mlnt[0] > R[4])                             /* cant exceed total */
             mlnt[0] = R[4];
@@ -953,6 +1034,8 @@ return cc;
 int32 op_cmpc (int32 *opnd, int32 cmpc5, int32 acc)
 {
 int32 cc, s1, s2, fill;
+int32 l1, l2, off, lnt, k;
+uint8 *p1, *p2;
 
 if (PSL & PSL_FPD) {                                    /* FPD set? */
     SETPC (fault_PC + STR_GETDPC (R[0]));               /* reset PC */
@@ -974,6 +1057,48 @@ else {
     PSL = PSL | PSL_FPD;
     }
 R[2] = R[2] & STR_LNMASK;                               /* mask src2len */
+for (;;) {                                              /* skip equal page spans */
+    l1 = R[0] & STR_LNMASK;
+    l2 = R[2];
+    lnt = STR_LNMASK + 1;
+    p1 = p2 = NULL;
+    if (l1) {                                           /* src1 left? */
+        if ((p1 = MapStr (R[1], RA, &off)) == NULL)
+            break;
+        lnt = VA_PAGSIZE - off;
+        if (lnt > l1)
+            lnt = l1;
+        }
+    if (l2) {                                           /* src2 left? */
+        if ((p2 = MapStr (R[3], RA, &off)) == NULL)
+            break;
+        if (lnt > (int32)(VA_PAGSIZE - off))
+            lnt = VA_PAGSIZE - off;
+        if (lnt > l2)
+            lnt = l2;
+        }
+    if (p1 && p2) {
+        if (memcmp (p1, p2, lnt) == 0)
+            k = lnt;
+        else for (k = 0; p1[k] == p2[k]; k++) ;
+        }
+    else if (p1)                                        /* src1 vs fill */
+        for (k = 0; (k < lnt) && (p1[k] == fill); k++) ;
+    else if (p2)                                        /* fill vs src2 */
+        for (k = 0; (k < lnt) && (p2[k] == fill); k++) ;
+    else break;                                         /* both done */
+    if (l1) {
+        R[0] = (R[0] & ~STR_LNMASK) | ((R[0] - k) & STR_LNMASK);
+        R[1] = R[1] + k;
+        }
+    if (l2) {
+        R[2] = (R[2] - k) & STR_LNMASK;
+        R[3] = R[3] + k;
+        }
+    extra_bytes = extra_bytes + k;
+    if (k < lnt)                                        /* mismatch? */
+        break;                                          /* loop below finds it */
+    }
 for (s1 = s2 = 0; ((R[0] | R[2]) & STR_LNMASK) != 0; extra_bytes++) {
     if (R[0] & STR_LNMASK)                              /* src1? read */
         s1 = Read (R[1], L_BYTE, RA);
@@ -1013,6 +1138,8 @@ return cc;
 int32 op_locskp (int32 *opnd, int32 skpc, int32 acc)
 {
 int32 c, match;
+int32 off, lnt, k;
+uint8 *p, *q;
 
 if (PSL & PSL_FPD) {                                    /* FPD set? */
     SETPC (fault_PC + STR_GETDPC (R[0]));               /* reset PC */
@@ -1024,6 +1151,24 @@ else {
     R[1] = opnd[2];                                     /* src addr */
     PSL = PSL | PSL_FPD;
     }
+while ((R[0] & STR_LNMASK) != 0) {                      /* page spans */
+    if ((p = MapStr (R[1], RA, &off)) == NULL)
+        break;
+    lnt = VA_PAGSIZE - off;
+    if (lnt > (R[0] & STR_LNMASK))
+        lnt = R[0] & STR_LNMASK;
+    if (skpc)
+        for (k = 0; (k < lnt) && (p[k] == match); k++) ;
+    else {
+        q = (uint8 *) memchr (p, match, lnt);
+        k = q? (int32)(q - p): lnt;
+        }
+    R[0] = (R[0] & ~STR_LNMASK) | ((R[0] - k) & STR_LNMASK);
+    R[1] = R[1] + k;
+    extra_bytes = extra_bytes + k;
+    if (k < lnt)                                        /* found? */
+        break;                                          /* loop below stops on it */
+    }
 for ( ; (R[0] & STR_LNMASK) != 0; extra_bytes++ ) {    /* loop thru string */
     c = Read (R[1], L_BYTE, RA);                        /* get src byte */
     if ((c == match) ^ skpc)                            /* match & locc? */
@@ -1053,6 +1198,8 @@ return (R[0]? 0: CC_Z);                                 /* set cc's */
 int32 op_scnspn (int32 *opnd, int32 spanc, int32 acc)
 {
 int32 c, t, mask;
+int32 off, lnt, k;
+uint8 *p, *tp[2] = { NULL, NULL };
 
 if (PSL & PSL_FPD) {                                    /* FPD set? */
     SETPC (fault_PC + STR_GETDPC (R[0]));               /* reset PC */
@@ -1065,6 +1212,30 @@ else {
     R[0] = STR_PACK (mask, opnd[0]);                    /* srclen + FPD data */
     PSL = PSL | PSL_FPD;
     }
+while ((R[0] & STR_LNMASK) != 0) {                      /* page spans */
+    if ((p = MapStr (R[1], RA, &off)) == NULL)
+        break;
+    lnt = VA_PAGSIZE - off;
+    if (lnt > (R[0] & STR_LNMASK))
+        lnt = R[0] & STR_LNMASK;
+    for (k = 0; k < lnt; k++) {
+        c = p[k];
+        if (tp[STR_TBL_PG (R[3], c)] == NULL)           /* table page unmapped? */
+            break;
+        if (((STR_TBL (R[3], tp, c) & mask) != 0) ^ spanc)
+            break;
+        }
+    R[0] = (R[0] & ~STR_LNMASK) | ((R[0] - k) & STR_LNMASK);
+    R[1] = R[1] + k;
+    extra_bytes = extra_bytes + k;
+    if (k < lnt) {                                      /* stopped early? */
+        c = p[k];
+        if (tp[STR_TBL_PG (R[3], c)] != NULL)           /* found? */
+            break;                                      /* loop below stops on it */
+        if (!MapStrTbl (R[3], c, tp, RA))               /* map table page */
+            break;
+        }
+    }
 for ( ; (R[0] & STR_LNMASK) != 0; extra_bytes++ ) {    /* loop thru string */
     c = Read (R[1], L_BYTE, RA);                        /* get byte */
     t = Read (R[3] + c, L_BYTE, RA);                    /* get table ent */
@@ -1260,50 +1431,47 @@ JUMP_ALWAYS (newpc);                                    /* set new PC */
 return newpsl & CC_MASK;                                /* set new cc */
 }
 
+/* Process control block longword offsets */
+
+#define PCB_R0          4                               /* R0-R13 */
+#define PCB_PC          18
+#define PCB_PSL         19
+#define PCB_P0BR        20                              /* P0BR, P0LR, P1BR, P1LR */
+#define PCB_LNT         24
+
 /* LDCPTX - load process context */
 
 void op_ldpctx (int32 acc)
 {
 uint32 newpc, newpsl, pcbpa, t;
+int32 pcb[PCB_LNT];
 
 if (PSL & PSL_CUR)                                      /* must be kernel */
     RSVD_INST_FAULT(LDPCTX);
 pcbpa = PCBB & PAMASK;                                  /* phys address */
-KSP = ReadLP (pcbpa);                                   /* restore stk ptrs */
-ESP = ReadLP (pcbpa + 4);
-SSP = ReadLP (pcbpa + 8);
-USP = ReadLP (pcbpa + 12);
-R[0] = ReadLP (pcbpa + 16);                             /* restore registers */
-R[1] = ReadLP (pcbpa + 20);
-R[2] = ReadLP (pcbpa + 24);
-R[3] = ReadLP (pcbpa + 28);
-R[4] = ReadLP (pcbpa + 32);
-R[5] = ReadLP (pcbpa + 36);
-R[6] = ReadLP (pcbpa + 40);
-R[7] = ReadLP (pcbpa + 44);
-R[8] = ReadLP (pcbpa + 48);
-R[9] = ReadLP (pcbpa + 52);
-R[10] = ReadLP (pcbpa + 56);
-R[11] = ReadLP (pcbpa + 60);
-R[12] = ReadLP (pcbpa + 64);
-R[13] = ReadLP (pcbpa + 68);
-newpc = ReadLP (pcbpa + 72);                            /* get PC, PSL */
-newpsl = ReadLP (pcbpa + 76);
-
-t = ReadLP (pcbpa + 80);
+ReadBlkLP (pcbpa, pcb, PCB_LNT);                        /* fetch PCB */
+KSP = pcb[0];                                           /* restore stk ptrs */
+ESP = pcb[1];
+SSP = pcb[2];
+USP = pcb[3];
+memcpy (R, pcb + PCB_R0, 14 * sizeof (int32));          /* restore R0-R13 */
+newpc = pcb[PCB_PC];                                    /* get PC, PSL */
+newpsl = pcb[PCB_PSL];
+
+t = pcb[PCB_P0BR];
 ML_PXBR_TEST (t);                                       /* validate P0BR */
 P0BR = t & BR_MASK;                                     /* restore P0BR */
-t = ReadLP (pcbpa + 84);
+t = pcb[PCB_P0BR + 1];
 LP_MBZ84_TEST (t);                                      /* test mbz */
 ML_LR_TEST (t & LR_MASK);                               /* validate P0LR */
 P0LR = t & LR_MASK;                                     /* restore P0LR */
 t = (t >> 24) & AST_MASK;
 LP_AST_TEST (t);                                        /* validate AST */
 ASTLVL = t;                                             /* restore AST */
-t = ReadLP (pcbpa + 88);
+t = pcb[PCB_P0BR + 2];
 ML_PXBR_TEST (t + 0x800000);                            /* validate P1BR */
 P1BR = t & BR_MASK;                                     /* restore P1BR */
-t = ReadLP (pcbpa + 92);
+t = pcb[PCB_P0BR + 3];
 LP_MBZ92_TEST (t);                                      /* test MBZ */
 ML_LR_TEST (t & LR_MASK);                               /* validate P1LR */
 P1LR = t & LR_MASK;                                     /* restore P1LR */
@@ -1327,6 +1495,7 @@ return;
 void op_svpctx (int32 acc)
 {
 int32 savpc, savpsl, pcbpa;
+int32 pcb[PCB_PSL + 1];
 
 if (PSL & PSL_CUR)                                      /* must be kernel */
     RSVD_INST_FAULT(SVPCTX);
@@ -1344,26 +1513,14 @@ else {
     PSL = PSL | PSL_IS;                                 /* set PSL<is> */
     }
 pcbpa = PCBB & PAMASK;
-WriteLP (pcbpa, KSP);                                   /* save stk ptrs */
-WriteLP (pcbpa + 4, ESP);
-WriteLP (pcbpa + 8, SSP);
-WriteLP (pcbpa + 12, USP);
-WriteLP (pcbpa + 16, R[0]);                             /* save registers */
-WriteLP (pcbpa + 20, R[1]);
-WriteLP (pcbpa + 24, R[2]);
-WriteLP (pcbpa + 28, R[3]);
-WriteLP (pcbpa + 32, R[4]);
-WriteLP (pcbpa + 36, R[5]);
-WriteLP (pcbpa + 40, R[6]);
-WriteLP (pcbpa + 44, R[7]);
-WriteLP (pcbpa + 48, R[8]);
-WriteLP (pcbpa + 52, R[9]);
-WriteLP (pcbpa + 56, R[10]);
-WriteLP (pcbpa + 60, R[11]);
-WriteLP (pcbpa + 64, R[12]);
-WriteLP (pcbpa + 68, R[13]);
-WriteLP (pcbpa + 72, savpc);                            /* save PC, PSL */
-WriteLP (pcbpa + 76, savpsl);
+pcb[0] = KSP;                                           /* save stk ptrs */
+pcb[1] = ESP;
+pcb[2] = SSP;
+pcb[3] = USP;
+memcpy (pcb + PCB_R0, R, 14 * sizeof (int32));          /* save R0-R13 */
+pcb[PCB_PC] = savpc;                                    /* save PC, PSL */
+pcb[PCB_PSL] = savpsl;
+WriteBlkLP (pcbpa, pcb, PCB_PSL + 1);                   /* store PCB */
 return;
 }
 
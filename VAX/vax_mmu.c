@@ -57,6 +57,8 @@ int32 d_p0br, d_p0lr;                                   /* dynamic copies */
 int32 d_p1br, d_p1lr;                                   /* altered per ucode */
 int32 d_sbr, d_slr;
 TLBENT stlb[VA_TBSIZE], ptlb[VA_TBSIZE];
+static int32 ptlb_used[VA_TBSIZE];                      /* filled ptlb indices */
+static int32 ptlb_nused = VA_TBSIZE + 1;                /* count, > size if unknown */
 static const int32 cvtacc[16] = { 0, 0,
     TLB_ACCW (KERN)+TLB_ACCR (KERN),
     TLB_ACCR (KERN),
@@ -198,6 +200,11 @@ if (acc & TLB_WACC) {                                   /* write? */
 vpn = VA_GETVPN (va);
 tbi = VA_GETTBI (vpn);
 if ((va & VA_S0) == 0) {                                /* process space? */
+    if (ptlb[tbi].tag == -1) {                          /* empty entry? */
+        if (ptlb_nused < VA_TBSIZE)                     /* note for zap_tb */
+            ptlb_used[ptlb_nused++] = tbi;
+        else ptlb_nused = VA_TBSIZE + 1;
+        }
     ptlb[tbi].tag = vpn;                                /* store tlb ent */
     ptlb[tbi].pte = tlbpte;
     return ptlb[tbi];
@@ -219,15 +226,29 @@ d_p1lr = (P1LR << 2) + 0x800000;                        /* VA<30> >> 7 */
 d_slr = (SLR << 2) + 0x1000000;                         /* VA<31> >> 7 */
 }
 
-/* Zap process (0) or whole (1) tb */
+/* Zap process (0) or whole (1) tb
+
+   A process uses only a few of the process tb entries between context
+   switches (LDPCTX), so fill records the entries it loads and only those
+   are cleared.  If the record overflowed, or entries were deposited, the
+   whole process tb is cleared.
+*/
 
 void zap_tb (int stb)
 {
 size_t i;
 
-for (i = 0; i < VA_TBSIZE; i++) {
-    ptlb[i].tag = ptlb[i].pte = -1;
-    if (stb)
+if (ptlb_nused <= VA_TBSIZE) {
+    for (i = 0; i < (size_t) ptlb_nused; i++)
+        ptlb[ptlb_used[i]].tag = ptlb[ptlb_used[i]].pte = -1;
+    }
+else {
+    for (i = 0; i < VA_TBSIZE; i++)
+        ptlb[i].tag = ptlb[i].pte = -1;
+    }
+ptlb_nused = 0;
+if (stb) {
+    for (i = 0; i < VA_TBSIZE; i++)
         stlb[i].tag = stlb[i].pte = -1;
     }
 }
@@ -289,6 +310,8 @@ else {
     if (tlbn) stlb[idx].tag = (int32) val;
     else ptlb[idx].tag = (int32) val;
     }
+if (tlbn == 0)                                          /* ptlb used unknown */
+    ptlb_nused = VA_TBSIZE + 1;
 return SCPE_OK;
 }
 
@@ -300,6 +323,7 @@ size_t i;
 
 for (i = 0; i < VA_TBSIZE; i++)
     stlb[i].tag = ptlb[i].tag = stlb[i].pte = ptlb[i].pte = -1;
+ptlb_nused = 0;
 return SCPE_OK;
 }
 
@@ -264,6 +264,106 @@ if (mapen) {                                            /* mapping on? */
 return va & PAMASK;                                     /* ret phys addr */
 }
 
+/* Map virtual for the string instructions
+
+   Inputs:
+        va      =       virtual address
+        acc     =       access code (RA or WA form)
+        off     =       pointer to byte offset of va within its page
+   Output:
+        host pointer to the byte at va, valid to the end of the page,
+        or NULL if the page is not in memory or host memory does not
+        hold VAX bytes in address order (big endian host)
+
+   The translation and access check are the same as Read or Write,
+   including any fault, so a string instruction can map each page
+   once and then process the page contiguous span with memcpy and
+   friends, updating its registers only at page boundaries.
+*/
+
+static SIM_INLINE uint8 *MapStr (uint32 va, int32 acc, int32 *off)
+{
+int32 vpn, tbi, pa;
+TLBENT xpte;
+
+mchk_va = va;
+*off = VA_GETOFF (va);
+if (mapen) {                                            /* mapping on? */
+    vpn = VA_GETVPN (va);
+    tbi = VA_GETTBI (vpn);
+    xpte = (va & VA_S0)? stlb[tbi]: ptlb[tbi];          /* access tlb */
+    if (((xpte.pte & acc) == 0) || (xpte.tag != vpn) ||
+        ((acc & TLB_WACC) && ((xpte.pte & TLB_M) == 0)))
+        xpte = fill (va, L_BYTE, acc, NULL);            /* fill if needed */
+    pa = (xpte.pte & TLB_PFN) | *off;                   /* get phys addr */
+    }
+else
+    pa = va & PAMASK;
+if (!sim_end || !ADDR_IS_MEM (pa | VA_M_OFF))           /* whole page in memory? */
+    return NULL;
+return ((uint8 *) M) + pa;
+}
+
+/* Map the page holding entry c of a 256 byte string table (MOVTC,
+   MOVTUC, SCANC, SPANC) into tp[0] (first page) or tp[1] (second).
+   Table pages are only mapped when an entry in them is used, so the
+   same pages are referenced, and can fault, as with Read.  The STR_TBL
+   macro then fetches entry c. */
+
+static SIM_INLINE t_bool MapStrTbl (uint32 tbl, int32 c, uint8 **tp, int32 acc)
+{
+int32 off;
+uint8 *p = MapStr (tbl + c, acc, &off);
+
+if (p == NULL)
+    return FALSE;
+tp[(VA_GETOFF (tbl) + c) >> VA_N_OFF] = p - off;        /* page base */
+return TRUE;
+}
+
+#define STR_TBL_PG(tbl,c)   ((VA_GETOFF (tbl) + (c)) >> VA_N_OFF)
+#define STR_TBL(tbl,tp,c)   (tp)[STR_TBL_PG (tbl, c)][(VA_GETOFF (tbl) + (c)) & VA_M_OFF]
+
+/* Map virtual for the queue instructions
+
+   Inputs:
+        va      =       virtual address
+        acc     =       access code (RA or WA form)
+   Output:
+        host pointer to the longword at va, or NULL if va is not
+        longword aligned or not in memory; if va is quadword aligned,
+        the pointer also covers va + 4
+
+   The translation and access check are the same as Read or Write,
+   including any fault, so a queue instruction can translate each
+   header or entry once and then read, interlock, and update it through
+   the pointer.  If NULL is returned, the caller uses Read and Write.
+*/
+
+static SIM_INLINE int32 *MapQue (uint32 va, int32 acc)
+{
+int32 vpn, tbi, pa;
+TLBENT xpte;
+
+if (va & 3)                                             /* unaligned? */
+    return NULL;
+mchk_va = va;
+if (mapen) {                                            /* mapping on? */
+    vpn = VA_GETVPN (va);
+    tbi = VA_GETTBI (vpn);
+    xpte = (va & VA_S0)? stlb[tbi]: ptlb[tbi];          /* access tlb */
+    if (((xpte.pte & acc) == 0) || (xpte.tag != vpn) ||
+        ((acc & TLB_WACC) && ((xpte.pte & TLB_M) == 0)))
+        xpte = fill (va, L_LONG, acc, NULL);            /* fill if needed */
+    pa = (xpte.pte & TLB_PFN) | VA_GETOFF (va);         /* get phys addr */
+    }
+else
+    pa = va & PAMASK;
+if (!ADDR_IS_MEM (pa | 4))                              /* in memory? */
+    return NULL;
+return (int32 *) (M + (pa >> 2));
+}
+
 /* Read aligned physical (in virtual context, unless indicated)
 
    Inputs:
@@ -423,6 +523,46 @@ else {
 return;
 }
 
+/* Read and write a block of aligned physical longwords
+
+   Inputs:
+        pa      =       physical address, longword aligned
+        buf     =       longword buffer
+        n       =       number of longwords
+   Output:
+        none
+
+   A block wholly in memory (a process control block, normally) is
+   copied with one bounds check; otherwise each longword goes through
+   ReadLP or WriteLP, in ascending address order.
+*/
+
+static SIM_INLINE void ReadBlkLP (uint32 pa, int32 *buf, int32 n)
+{
+int32 i;
+
+if (ADDR_IS_MEM (pa) && ADDR_IS_MEM (pa + (n << 2) - 1)) {
+    memcpy (buf, M + (pa >> 2), n << 2);
+    return;
+    }
+for (i = 0; i < n; i++)
+    buf[i] = ReadLP (pa + (i << 2));
+return;
+}
+
+static SIM_INLINE void WriteBlkLP (uint32 pa, const int32 *buf, int32 n)
+{
+int32 i;
+
+if (ADDR_IS_MEM (pa) && ADDR_IS_MEM (pa + (n << 2) - 1)) {
+    memcpy (M + (pa >> 2), buf, n << 2);
+    return;
+    }
+for (i = 0; i < n; i++)
+    WriteLP (pa + (i << 2), buf[i]);
+return;
+}
+
 /* Write unaligned physical (in virtual context)
 
    Inputs:
@@ -46,13 +46,21 @@
         tlb_ia                  TLB invalidate all
         tlb_is                  TLB invalidate single
         tlb_set_cm              TLB set current mode
+
+   The architectural TLBs are kept in entry number order, as PALcode sees
+   them through the NLU pointer.  In front of each is a direct mapped micro
+   TLB, indexed by the low bits of the vpn and tagged with vpn and ASN, which
+   holds the results of recent searches.  A micro TLB entry remains valid
+   across ASN changes; it is discarded only when the TLB entry it was taken
+   from is replaced or invalidated.
 */
 
 #include "alpha_defs.h"
 #include "alpha_ev5_defs.h"
 
-#define ITLB_SORT       qsort (itlb, ITLB_SIZE, sizeof (TLBENT), &tlb_comp);
-#define DTLB_SORT       qsort (dtlb, DTLB_SIZE, sizeof (TLBENT), &tlb_comp);
+#define MTLB_WIDTH      8                               /* micro TLB */
+#define MTLB_SIZE       (1u << MTLB_WIDTH)
+#define MTLB_MASK       (MTLB_SIZE - 1)
 #define TLB_ESIZE       (sizeof (TLBENT)/sizeof (uint32))
 #define MM_RW(x)        (((x) & PTE_FOW)? EXC_W: EXC_R)
 
@@ -62,12 +70,14 @@ uint32 itlb_asn = 0;
 uint32 itlb_nlu = 0;
 TLBENT i_mini_tlb;
 TLBENT itlb[ITLB_SIZE];
+TLBENT i_micro_tlb[MTLB_SIZE];
 uint32 dtlb_cm = 0;
 uint32 dtlb_spage = 0;
 uint32 dtlb_asn = 0;
 uint32 dtlb_nlu = 0;
 TLBENT d_mini_tlb;
 TLBENT dtlb[DTLB_SIZE];
+TLBENT d_micro_tlb[MTLB_SIZE];
 
 uint32 cm_eacc = ACC_E (MODE_K);                        /* precomputed */
 uint32 cm_racc = ACC_R (MODE_K);                        /* access checks */
@@ -79,9 +89,11 @@ extern jmp_buf save_env;
 
 uint32 mm_exc (uint32 macc);
 void tlb_inval (TLBENT *tlbp);
+TLBENT *tlb_search (TLBENT *tlb, uint32 size, uint32 asn, uint32 vpn);
+void mtlb_inval (TLBENT *mtlb, TLBENT *tlbp);
+void mtlb_flush (TLBENT *mtlb);
 t_stat itlb_reset (void);
 t_stat dtlb_reset (void);
-int tlb_comp (const void *e1, const void *e2);
 t_stat tlb_reset (DEVICE *dptr);
 
 /* TLB data structures
@@ -198,15 +210,17 @@ uint32 vpn = VA_GETVPN (va);
 TLBENT *itlbp, *dtlbp;
 
 if ((va_sext != 0) && (va_sext != VA_M_SEXT)) return;
-if ((flags & TLB_CI) && (itlbp = itlb_lookup (vpn))) {
+if ((flags & TLB_CI) &&
+    (itlbp = tlb_search (itlb, ITLB_SIZE, itlb_asn, vpn))) {
+    mtlb_inval (i_micro_tlb, itlbp);
     tlb_inval (itlbp);
     tlb_inval (&i_mini_tlb);
-    ITLB_SORT;
     }
-if ((flags & TLB_CD) && (dtlbp = dtlb_lookup (vpn))) {
+if ((flags & TLB_CD) &&
+    (dtlbp = tlb_search (dtlb, DTLB_SIZE, dtlb_asn, vpn))) {
+    mtlb_inval (d_micro_tlb, dtlbp);
     tlb_inval (dtlbp);
     tlb_inval (&d_mini_tlb);
-    DTLB_SORT;
     }
 return;
 }
@@ -224,17 +238,21 @@ if (flags & TLB_CA) {
     }
 if (flags & TLB_CI) {
     for (i = 0; i < ITLB_SIZE; i++) {
-        if (!(itlb[i].pte & PTE_ASM)) tlb_inval (&itlb[i]);
+        if (!(itlb[i].pte & PTE_ASM)) {
+            mtlb_inval (i_micro_tlb, &itlb[i]);
+            tlb_inval (&itlb[i]);
+            }
         }
     tlb_inval (&i_mini_tlb);
-    ITLB_SORT;
     }
 if (flags & TLB_CD) {
     for (i = 0; i < DTLB_SIZE; i++) {
-        if (!(dtlb[i].pte & PTE_ASM)) tlb_inval (&dtlb[i]);
+        if (!(dtlb[i].pte & PTE_ASM)) {
+            mtlb_inval (d_micro_tlb, &dtlb[i]);
+            tlb_inval (&dtlb[i]);
+            }
         }
     tlb_inval (&d_mini_tlb);
-    DTLB_SORT;
     }
 return;
 }
@@ -243,58 +261,48 @@ return;
 
 TLBENT *itlb_lookup (uint32 vpn)
 {
-int32 p, hi, lo;
+TLBENT *mp, *tlbp;
 
 if (vpn == i_mini_tlb.tag) return &i_mini_tlb;
-lo = 0;                                                 /* initial bounds */
-hi = ITLB_SIZE - 1;
-do {
-    p = (lo + hi) >> 1;                                 /* probe */
-    if ((itlb_asn == itlb[p].asn) && 
-        (((vpn ^ itlb[p].tag) &
-         ~((uint32) itlb[p].gh_mask)) == 0)) {          /* match to TLB? */
-        i_mini_tlb.tag = vpn;
-        i_mini_tlb.pte = itlb[p].pte;
-        i_mini_tlb.pfn = itlb[p].pfn;
-        itlb_nlu = itlb[p].idx + 1;
-        if (itlb_nlu >= ITLB_SIZE) itlb_nlu = 0;
-        return &i_mini_tlb;
-        }
-    if ((itlb_asn < itlb[p].asn) ||
-        ((itlb_asn == itlb[p].asn) && (vpn < itlb[p].tag)))
-        hi = p - 1;                                     /* go down? p is upper */
-    else lo = p + 1;                                    /* go up? p is lower */
+mp = i_micro_tlb + (vpn & MTLB_MASK);
+if ((mp->tag != vpn) || (mp->asn != itlb_asn)) {        /* micro TLB miss? */
+    if (!(tlbp = tlb_search (itlb, ITLB_SIZE, itlb_asn, vpn)))
+        return NULL;
+    mp->tag = vpn;                                      /* fill micro TLB */
+    mp->asn = itlb_asn;
+    mp->idx = tlbp->idx;
+    mp->pte = tlbp->pte;
+    mp->pfn = tlbp->pfn;
     }
-while (lo <= hi);
-return NULL;
+i_mini_tlb.tag = vpn;
+i_mini_tlb.pte = mp->pte;
+i_mini_tlb.pfn = mp->pfn;
+itlb_nlu = mp->idx + 1;
+if (itlb_nlu >= ITLB_SIZE) itlb_nlu = 0;
+return &i_mini_tlb;
 }
 
 TLBENT *dtlb_lookup (uint32 vpn)
 {
-int32 p, hi, lo;
+TLBENT *mp, *tlbp;
 
 if (vpn == d_mini_tlb.tag) return &d_mini_tlb;
-lo = 0;                                                 /* initial bounds */
-hi = DTLB_SIZE - 1;
-do {
-    p = (lo + hi) >> 1;                                 /* probe */
-    if ((dtlb_asn == dtlb[p].asn) && 
-        (((vpn ^ dtlb[p].tag) &
-         ~((uint32) dtlb[p].gh_mask)) == 0)) {          /* match to TLB? */
-        d_mini_tlb.tag = vpn;
-        d_mini_tlb.pte = dtlb[p].pte;
-        d_mini_tlb.pfn = dtlb[p].pfn;
-        dtlb_nlu = dtlb[p].idx + 1;
-        if (dtlb_nlu >= DTLB_SIZE) dtlb_nlu = 0;
-        return &d_mini_tlb;
-        }
-    if ((dtlb_asn < dtlb[p].asn) ||
-        ((dtlb_asn == dtlb[p].asn) && (vpn < dtlb[p].tag)))
-        hi = p - 1;                                     /* go down? p is upper */
-    else lo = p + 1;                                    /* go up? p is lower */
+mp = d_micro_tlb + (vpn & MTLB_MASK);
+if ((mp->tag != vpn) || (mp->asn != dtlb_asn)) {        /* micro TLB miss? */
+    if (!(tlbp = tlb_search (dtlb, DTLB_SIZE, dtlb_asn, vpn)))
+        return NULL;
+    mp->tag = vpn;                                      /* fill micro TLB */
+    mp->asn = dtlb_asn;
+    mp->idx = tlbp->idx;
+    mp->pte = tlbp->pte;
+    mp->pfn = tlbp->pfn;
     }
-while (lo <= hi);
-return NULL;
+d_mini_tlb.tag = vpn;
+d_mini_tlb.pte = mp->pte;
+d_mini_tlb.pfn = mp->pfn;
+dtlb_nlu = mp->idx + 1;
+if (dtlb_nlu >= DTLB_SIZE) dtlb_nlu = 0;
+return &d_mini_tlb;
 }
 
 /* Load TLB entry at NLU pointer, advance NLU pointer */
@@ -308,6 +316,7 @@ for (i = 0; i < ITLB_SIZE; i++) {
         TLBENT *tlbp = itlb + i;
         itlb_nlu = itlb_nlu + 1;
         if (itlb_nlu >= ITLB_SIZE) itlb_nlu = 0;
+        mtlb_inval (i_micro_tlb, tlbp);                 /* drop old mapping */
         tlbp->tag = vpn;
         tlbp->pte = (uint32) (l3pte & PTE_MASK) ^ (PTE_FOR|PTE_FOR|PTE_FOE);
         tlbp->pfn = ((uint32) (l3pte >> PTE_V_PFN)) & PFN_MASK;
@@ -315,7 +324,6 @@ for (i = 0; i < ITLB_SIZE; i++) {
         gh = PTE_GETGH (tlbp->pte);
         tlbp->gh_mask = (1u << (3 * gh)) - 1;
         tlb_inval (&i_mini_tlb);
-        ITLB_SORT;
         return tlbp;
         }
     }
@@ -333,6 +341,7 @@ for (i = 0; i < DTLB_SIZE; i++) {
         TLBENT *tlbp = dtlb + i;
         dtlb_nlu = dtlb_nlu + 1;
         if (dtlb_nlu >= ITLB_SIZE) dtlb_nlu = 0;
+        mtlb_inval (d_micro_tlb, tlbp);                 /* drop old mapping */
         tlbp->tag = vpn;
         tlbp->pte = (uint32) (l3pte & PTE_MASK) ^ (PTE_FOR|PTE_FOR|PTE_FOE);
         tlbp->pfn = ((uint32) (l3pte >> PTE_V_PFN)) & PFN_MASK;
@@ -340,7 +349,6 @@ for (i = 0; i < DTLB_SIZE; i++) {
         gh = PTE_GETGH (tlbp->pte);
         tlbp->gh_mask = (1u << (3 * gh)) - 1;
         tlb_inval (&d_mini_tlb);
-        DTLB_SORT;
         return tlbp;
         }
     }
@@ -398,7 +406,6 @@ for (i = 0; i < ITLB_SIZE; i++) {
     if (itlb[i].pte & PTE_ASM) itlb[i].asn = asn;
     }
 tlb_inval (&i_mini_tlb);
-ITLB_SORT;
 return;
 } 
 
@@ -411,7 +418,6 @@ for (i = 0; i < DTLB_SIZE; i++) {
     if (dtlb[i].pte & PTE_ASM) dtlb[i].asn = asn;
     }
 tlb_inval (&d_mini_tlb);
-DTLB_SORT;
 return;
 }
 
@@ -453,8 +459,10 @@ if (cm >= 0) {
     dtlb_set_cm (cm);
     return cm;
     }
-itlb_set_cm (itlb_cm);
-dtlb_set_cm (dtlb_cm);
+itlb_set_cm (itlb_cm);                                  /* resync; registers */
+dtlb_set_cm (dtlb_cm);                                  /* may have changed, */
+mtlb_flush (i_micro_tlb);                               /* so micro TLBs */
+mtlb_flush (d_micro_tlb);                               /* may be stale */
 return dtlb_cm;
 }
 
@@ -470,18 +478,50 @@ tlbp->gh_mask = 0;
 return;
 }
 
-/* Compare routine for qsort */
+/* Search TLB for vpn in address space asn */
 
-int tlb_comp (const void *e1, const void *e2)
+TLBENT *tlb_search (TLBENT *tlb, uint32 size, uint32 asn, uint32 vpn)
 {
-const TLBENT *t1 = (const TLBENT *) e1;
-const TLBENT *t2 = (const TLBENT *) e2;
+uint32 i;
 
-if (t1->asn > t2->asn) return +1;
-if (t1->asn < t2->asn) return -1;
-if (t1->tag > t2->tag) return +1;
-if (t1->tag < t2->tag) return -1;
-return 0;
+for (i = 0; i < size; i++) {
+    if ((asn == tlb[i].asn) &&
+        (((vpn ^ tlb[i].tag) & ~((uint32) tlb[i].gh_mask)) == 0))
+        return &tlb[i];                                 /* match to TLB */
+    }
+return NULL;
+}
+
+/* Discard micro TLB entries taken from a TLB entry */
+
+void mtlb_inval (TLBENT *mtlb, TLBENT *tlbp)
+{
+uint32 i;
+
+if (tlbp->tag == INV_TAG)                               /* nothing cached */
+    return;
+if (tlbp->gh_mask == 0) {                               /* single page? */
+    TLBENT *mp = mtlb + (tlbp->tag & MTLB_MASK);
+    if (mp->idx == tlbp->idx)
+        mp->tag = INV_TAG;
+    return;
+    }
+for (i = 0; i < MTLB_SIZE; i++) {                       /* granularity hint */
+    if (mtlb[i].idx == tlbp->idx)
+        mtlb[i].tag = INV_TAG;
+    }
+return;
+}
+
+/* Flush micro TLB */
+
+void mtlb_flush (TLBENT *mtlb)
+{
+uint32 i;
+
+for (i = 0; i < MTLB_SIZE; i++)
+    mtlb[i].tag = INV_TAG;
+return;
 }
 
 /* ITLB reset */
@@ -500,6 +540,7 @@ for (i = 0; i < ITLB_SIZE; i++) {
     itlb[i].idx = i;
     }
 tlb_inval (&i_mini_tlb);
+mtlb_flush (i_micro_tlb);
 return SCPE_OK;
 }
 /* DTLB reset */
@@ -518,6 +559,7 @@ for (i = 0; i < DTLB_SIZE; i++) {
     dtlb[i].idx = i;
     }
 tlb_inval (&d_mini_tlb);
+mtlb_flush (d_micro_tlb);
 return SCPE_OK;
 }
 
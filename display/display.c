@@ -246,8 +246,8 @@ static struct display displays[] = {
 
 /*
  * Unit time (in microseconds) used to store display point time to
- * live at current aging level.  If this is too small, delay values
- * cannot fit in an unsigned short.  If it is too large all pixels
+ * live at current aging level.  If this is too small, there will be
+ * many (mostly empty) aging buckets.  If it is too large all pixels
  * will age at once.  Perhaps a suitable value should be calculated at
  * run time?  When display_init() calculates refresh_interval it
  * sanity checks for both cases.
@@ -305,51 +305,52 @@ static struct display displays[] = {
 
 /*
  * Each point on the display is represented by a "struct point".  When
- * a point isn't dark (intensity > 0), it is linked into a circular,
- * doubly linked delta queue (a priority queue where "delay"
- * represents the time difference from the previous entry (if any) in
- * the queue.
+ * a point isn't dark (intensity > 0), it is linked into one of
+ * refresh_interval circular, doubly linked buckets (a calendar queue
+ * with one bucket per DELAY_UNIT of the refresh interval).  A point
+ * lives in the bucket for the tick at which it was last drawn.
  *
  * All points are aged refresh_rate times/second, each time moved to the
- * next (logarithmically) lower intensity level.  When display_age() is
- * called, only the entries which have expired are processed.  Calling
- * display_age() often allows spreading out the workload.
+ * next (logarithmically) lower intensity level.  Since every point ages
+ * by exactly refresh_interval, a bucket comes due once per trip around
+ * the ring, and the points in it are aged in place without being moved.
+ * When display_age() is called, only the buckets for the elapsed ticks
+ * are processed.  Calling display_age() often allows spreading out the
+ * workload.
  *
  * An alternative would be to have intensity levels represent linear
  * decreases in intensity, and have the decay time at each level change.
  * Inverting the decay function for a multi-component phosphor may be
  * tricky, and the two different colors would need different time tables.
  * Furthermore, it would require finding the correct location in the
- * queue when adding a point (currently only need to add points at end)
+ * queue when adding a point (currently only need to add points at the
+ * current bucket)
  */
 
 /*
- * 12 bytes/entry on 32-bit system when REFRESH_RATE > 15
+ * 12 bytes/entry on 32-bit system
  * (requires 3MB for 512x512 display).
  */
 
-typedef unsigned short delay_t;
-#define DELAY_T_MAX USHRT_MAX
-
 struct point {
-    struct point *next;         /* next entry in queue */
-    struct point *prev;         /* prev entry in queue */
-    delay_t delay;              /* delta T in DELAY_UNITs */
+    struct point *next;         /* next entry in bucket */
+    struct point *prev;         /* prev entry in bucket */
     unsigned char ttl;          /* zero means off, not linked in */
     unsigned char level : 7;    /* intensity level */
     unsigned char color : 1;    /* for VR20 (two colors) */
 };
 
 static struct point *points;    /* allocated array of points */
-static struct point _head;
-#define head (&_head)
 
 /*
- * time span of all entries in queue
- * should never exceed refresh_interval
- * (should be possible to make this a delay_t)
+ * refresh_interval bucket list heads, and the bucket for the
+ * current DELAY_UNIT tick
  */
-static long queue_interval;
+static struct point *buckets;
+static int bucket_now;
+
+/* number of points currently lit (linked into a bucket) */
+static long lit_points;
 
 /* convert X,Y to a "struct point *" */
 #define P(X,Y) (points + (X) + ((Y)*(size_t)xpixels))
@@ -407,36 +408,26 @@ display_lp_radius(int r)
 }
 
 /*
- * from display_age and display_point
+ * from display_point
  * since all points age at the same rate,
- * only adds points at end of list.
+ * a point drawn now is next due one refresh_interval from now,
+ * which is when the current bucket comes around again.
  */
 static void
 queue_point(struct point *p)
 {
-    int d;
-
-    d = refresh_interval - queue_interval;
-    queue_interval += d;
-    /* queue_interval should now be == refresh_interval */
+    struct point *b = buckets + bucket_now;
 
 #ifdef PARANOIA
     if (p->ttl == 0 || p->ttl > MAXTTL)
     printf("queuing %d,%d level %d!\n", X(p), Y(p), p->level);
-    if (d > DELAY_T_MAX)
-    printf("queuing %d,%d delay %d!\n", X(p), Y(p), d);
-    if (queue_interval > DELAY_T_MAX)
-    printf("queue_interval (%d) > DELAY_T_MAX (%d)\n",
-           (int)queue_interval, DELAY_T_MAX);
 #endif /* PARANOIA defined */
 
-    p->next = head;
-    p->prev = head->prev;
+    p->next = b;
+    p->prev = b->prev;
 
-    head->prev->next = p;
-    head->prev = p;
-
-    p->delay = d;
+    b->prev->next = p;
+    b->prev = p;
 }
 
 /*
@@ -445,7 +436,7 @@ queue_point(struct point *p)
 int
 display_is_blank(void)
 {
-    return head->next == head;
+    return lit_points == 0;
 }
 
 /*
@@ -614,7 +605,7 @@ int
 display_age(int t,          /* simulated us since last call */
         int slowdown)       /* slowdown to simulated speed */
 {
-    struct point *p;
+    struct point *p, *next, *b;
     static int elapsed = 0;
     static int refresh_elapsed = 0; /* in units of DELAY_UNIT bounded by refresh_interval */
     int changed;
@@ -640,36 +631,28 @@ display_age(int t,          /* simulated us since last call */
         refresh_elapsed = 0;
         }
 
-    while ((p = head->next) != head) {
-        int x, y;
-
-        /* look at oldest entry */
-        if (p->delay > t) {         /* further than our reach? */
-            p->delay -= t;          /* update head */
-            queue_interval -= t;    /* update span */
-            break;                  /* quit */
-            }
-
-        x = X(p);
-        y = Y(p);
+    /* step through the buckets for each elapsed tick */
+    while ((t-- > 0) && (lit_points > 0)) {
+        if (++bucket_now >= refresh_interval)
+            bucket_now = 0;
+        b = buckets + bucket_now;
+        for (p = b->next; p != b; p = next) {
+            next = p->next;
 #ifdef PARANOIA
-        if (p->ttl == 0)
-            printf("BUG: age %d,%d ttl zero\n", x, y);
+            if (p->ttl == 0)
+                printf("BUG: age %d,%d ttl zero\n", (int)X(p), (int)Y(p));
 #endif /* PARANOIA defined */
 
-        /* dequeue point */
-        p->prev->next = p->next;
-        p->next->prev = p->prev;
-
-        t -= p->delay;              /* lessen our reach */
-        queue_interval -= p->delay; /* update queue span */
+            ws_display_point(X(p), Y(p), colors[p->color][p->level][--p->ttl]);
+            changed = 1;
 
-        ws_display_point(x, y, colors[p->color][p->level][--p->ttl]);
-        changed = 1;
-
-        /* queue it back up, unless we just turned it off! */
-        if (p->ttl > 0)
-            queue_point(p);
+            /* points stay in their bucket, unless we just turned it off! */
+            if (p->ttl == 0) {
+                p->prev->next = next;
+                next->prev = p->prev;
+                --lit_points;
+                }
+            }
         }
     return changed;
 } /* display_age */
@@ -709,15 +692,12 @@ intensify(int x,            /* 0..xpixels */
                x, y, p->level, p->ttl, level);
 #endif /* LOUD defined */
 
-        /* unlink from delta queue */
+        /* unlink from its bucket */
         p->prev->next = p->next;
-
-        if (p->next == head)
-            queue_interval -= p->delay;
-        else
-            p->next->delay += p->delay;
         p->next->prev = p->prev;
         }
+    else
+        ++lit_points;
 
     bleed = 0;              /* no bleeding for now */
 
@@ -740,7 +720,7 @@ intensify(int x,            /* 0..xpixels */
         ws_display_point(x, y, colors[p->color][p->level][p->ttl-1]);
         }
 
-    queue_point(p);         /* put at end of list */
+    queue_point(p);         /* put in current bucket */
     return bleed;
 }
 
@@ -886,9 +866,6 @@ display_init(enum display_type type, int sf, void *dptr)
         goto failed;
         }
 
-    /* Initialize display list */
-    head->next = head->prev = head;
-
     display_type = type;
     scale = sf;
 
@@ -935,13 +912,15 @@ display_init(enum display_type type, int sf, void *dptr)
         refresh_interval = 1;
         }
 
-    /* point lifetime in DELAY_UNITs will not fit in p->delay field! */
-    if (refresh_interval > DELAY_T_MAX) {
-        /* increase DELAY_UNIT? */
-        fprintf(stderr, "bad refresh_interval %d > DELAY_T_MAX %d\r\n",
-            refresh_interval, DELAY_T_MAX);
+    /* Initialize display list buckets */
+    buckets = (struct point *)calloc((size_t)refresh_interval,
+                    sizeof(struct point));
+    if (!buckets)
         goto failed;
-        }
+    for (i = 0; i < refresh_interval; i++)
+        buckets[i].next = buckets[i].prev = buckets + i;
+    bucket_now = 0;
+    lit_points = 0;
 
     /*
      * before phosphor_init;
@@ -983,6 +962,7 @@ display_close(void *dptr)
         return;
 
     free (points);
+    free (buckets);
     ws_shutdown();
 
     initialized = 0;
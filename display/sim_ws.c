@@ -75,6 +75,7 @@ static const char *window_name;
 static uint32 *colors = NULL;
 static uint32 ncolors = 0, size_colors = 0;
 static uint32 *surface = NULL;
+static int dirty_top, dirty_bottom;                     /* rows changed since last ws_sync */
 static uint32 ws_palette[2];                            /* Monochrome palette */
 typedef struct cursor {
     Uint8 *data;
@@ -402,6 +403,8 @@ ws_init(const char *name, int xp, int yp, int colors, void *dptr)
     ws_palette[1] = vid_map_rgb (0xFF, 0xFF, 0xFF);     /* white */
     for (i=0; i<xpixels*ypixels; i++)
         surface[i] = ws_palette[0];
+    dirty_top = 0;
+    dirty_bottom = ypixels - 1;
     return ret;
 }
 
@@ -454,13 +457,17 @@ ws_display_point(int x, int y, void *color)
 {
     uint32 *brush = (uint32 *)color;
 
-    if (x > xpixels || y > ypixels)
+    if (x >= xpixels || y >= ypixels)
         return;
 
     y = ypixels - 1 - y;                /* invert y, top left origin */
 
     if (brush == NULL)
         brush = (uint32 *)ws_color_black ();
+    if (y < dirty_top)
+        dirty_top = y;
+    if (y + pix_size - 1 > dirty_bottom)
+        dirty_bottom = y + pix_size - 1;
     if (pix_size > 1) {
         int i, j;
         
@@ -474,8 +481,15 @@ ws_display_point(int x, int y, void *color)
   
 void
 ws_sync(void) {
-    vid_draw (0, 0, xpixels, ypixels, surface);
+    /* only send the band of rows touched since the last sync */
+    if (dirty_top > dirty_bottom)
+        return;
+    if (dirty_bottom >= ypixels)
+        dirty_bottom = ypixels - 1;
+    vid_draw (0, dirty_top, xpixels, dirty_bottom - dirty_top + 1, surface + dirty_top*xpixels);
     vid_refresh ();
+    dirty_top = ypixels;
+    dirty_bottom = -1;
 }
 
 void
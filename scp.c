@@ -241,6 +241,13 @@
 #endif
 #include <sys/stat.h>
 #include <setjmp.h>
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#include <x86intrin.h>
+#define SIM_BENCH_TSC 1
+#elif defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+#include <intrin.h>
+#define SIM_BENCH_TSC 1
+#endif
 
 #if defined(HAVE_DLOPEN)                                /* Dynamic Readline support */
 #include <dlfcn.h>
@@ -605,6 +612,9 @@ double sim_runlimit_d = 0.0;
 double sim_runlimit_d_initial = 0.0;
 int32 sim_runlimit_switches = 0;
 t_bool sim_runlimit_enabled = FALSE;
+static t_bool sim_bench_active = FALSE;             /* BENCHMARK command executing */
+static double sim_bench_events = 0.0;               /* events dispatched during benchmark */
+static double sim_bench_event_ticks = 0.0;          /* host ticks spent dispatching them */
 char *sim_sub_instr = NULL;         /* Copy of pre-substitution buffer contents */
 char *sim_sub_instr_buf = NULL;     /* Buffer address that substitutions were saved in */
 size_t sim_sub_instr_size = 0;      /* substitution buffer size */
@@ -1034,6 +1044,27 @@ static const char simh_help[] =
       "4Switches\n"
       " If the STEP command is invoked with the -T switch, the step command will\n"
       " cause execution to run for microseconds rather than instructions.\n"
+#define HLP_BENCHMARK   "*Commands Running_A_Simulated_Program BENCHMARK"
+      "3BENCHMARK\n"
+      " The BENCHMARK command measures the simulator's instruction throughput.\n"
+      " It resumes execution at the current PC for the number of instructions\n"
+      " given by its argument (default 100000000) with throttling and idling\n"
+      " suspended, and then reports the results on a single line:\n\n"
+      "++BENCHMARK: sim=\"PDP-8\" instructions=100000000 seconds=0.842113\n"
+      "++mips=118.749 host_ns_per_instruction=8.42\n"
+      "++host_cycles_per_instruction=25.31 events=48830\n"
+      "++event_seconds=0.009811 event_overhead_pct=1.17 stop=\"Step expired\"\n\n"
+      " (shown wrapped here) where events counts the event queue dispatches\n"
+      " which occurred while running and event_seconds is the host time spent\n"
+      " in them.  host_cycles_per_instruction is only reported on hosts which\n"
+      " provide a cycle counter.  For simulators which count memory or machine\n"
+      " cycles rather than instructions, the instruction figures are in those\n"
+      " units.  The simulated program should be a CPU-bound loop which has been\n"
+      " loaded or deposited into memory beforehand.  If execution stops before\n"
+      " the requested count, the results cover the portion which ran and the\n"
+      " stop reason is also displayed.\n\n"
+      " The makefile's benchmark target runs each built simulator's\n"
+      " tests/<simulator>_benchmark.ini workload.\n"
 #define HLP_NEXT        "*Commands Running_A_Simulated_Program NEXT"
       "3NEXT\n"
       " The NEXT command (abbreviated N) resumes execution at the current PC for\n"
@@ -1363,6 +1394,20 @@ static const char simh_help[] =
       " The size of the circular memory buffer that is used is specified on\n"
       " the SET DEBUG command line, for example:\n\n"
       "++SET DEBUG -B <sizeinMB> <debug-destination>\n\n"
+      "5-X\n"
+      " The -X switch records debug messages as compact binary records in a\n"
+      " circular buffer in memory rather than formatting them as they occur.\n"
+      " The records are rendered as text to the debug destination when debug\n"
+      " output is disabled.  This makes it practical to leave debugging enabled\n"
+      " for long periods, for example while booting an operating system, to\n"
+      " capture the events leading up to a problem.  The buffer size is\n"
+      " specified in the same way as for -B:\n\n"
+      "++SET DEBUG -X <sizeinMB> <debug-destination>\n\n"
+      " Only sim_debug messages are recorded; other debug output, such as\n"
+      " register bit field displays, is written directly.  A record refers\n"
+      " to its message format rather than copying it, so -X relies on the\n"
+      " simulator passing sim_debug literal format strings, as the simulators\n"
+      " in this distribution do.\n"
 #define HLP_SET_BREAK  "*Commands SET Breakpoints"
       "3Breakpoints\n"
       "+SET BREAK <list>            set breakpoints\n"
@@ -1404,9 +1449,18 @@ static const char simh_help[] =
       "+SET CLOCK catchup           enable catchup clock ticks\n"
       "+SET CLOCK calib=n%%          specify idle calibration skip %%\n"
       "+SET CLOCK calib=ALWAYS      specify calibration independent of idle\n"
+      "+SET CLOCK warp              skip idle time\n"
+      "+SET CLOCK nowarp            idle in real time\n"
       "+SET CLOCK stop=n            stop execution after n instructions\n\n"
       " The SET CLOCK STOP command allows execution to have a bound when\n"
-      " execution starts with a BOOT, NEXT or CONTINUE command.\n"
+      " execution starts with a BOOT, NEXT or CONTINUE command.\n\n"
+      " The SET CLOCK WARP command is intended for unattended test runs.  When\n"
+      " the simulated system idles, simulated time advances directly to the next\n"
+      " pending event rather than waiting in real time, and the calibrated clocks\n"
+      " tick on instruction count rather than tracking wall clock time.  Time\n"
+      " as seen by the simulated system remains consistent, but runs faster than\n"
+      " real time.  Warping only happens where the simulator idles, so idling\n"
+      " must be enabled (SET CPU IDLE).\n"
 #define HLP_SET_ASYNCH "*Commands SET Asynch"
       "3Asynch\n"
       "+SET ASYNCH                  enable asynchronous I/O\n"
@@ -2389,6 +2443,7 @@ static CTAB cmd_table[] = {
     { "GO",         &run_cmd,       RU_GO,      HLP_GO,         NULL, &run_cmd_message },
     { "STEP",       &run_cmd,       RU_STEP,    HLP_STEP,       NULL, &run_cmd_message },
     { "NEXT",       &run_cmd,       RU_NEXT,    HLP_NEXT,       NULL, &run_cmd_message },
+    { "BENCHMARK",  &benchmark_cmd, 0,          HLP_BENCHMARK,  NULL, NULL },
     { "CONTINUE",   &run_cmd,       RU_CONT,    HLP_CONTINUE,   NULL, &run_cmd_message },
     { "BOOT",       &run_cmd,       RU_BOOT,    HLP_BOOT,       NULL, &run_cmd_message },
     { "BREAK",      &brk_cmd,       SSH_ST,     HLP_BREAK,      NULL, NULL },
@@ -4969,7 +5024,116 @@ stop_cpu = FALSE;                   /* Clear in case sleep was interrupted */
 return SCPE_OK;
 }
 
-/* Goto command */
+/* Goto command
+
+   Labels are located through a per file index which is built by a single
+   scan of the do file the first time a GOTO or CALL references it.  The
+   index records, in file order, each label, the file position and line
+   number just past the label line and the label line itself (for -v echo).
+   A few recently used files are kept; an index is discarded and rebuilt
+   when the size or modification time of the file changes.  If the index
+   can't be built the file is searched directly as it always was.
+*/
+
+#define DO_LABEL_FILES  8                               /* do files with cached label indexes */
+
+typedef struct {
+    char        *name;                                  /* label glyph */
+    char        *text;                                  /* label line (for echo) */
+    long        fpos;                                   /* position after label line */
+    int32       line;                                   /* line number of label */
+    } DO_LABEL;
+
+typedef struct {
+    char        filename[CBUFSIZE];                     /* do file path */
+    t_offset    size;                                   /* file size and */
+    time_t      mtime;                                  /*   modify time when indexed */
+    uint32      lastuse;                                /* LRU stamp */
+    int32       count;                                  /* labels in file */
+    int32       alloc;                                  /* labels allocated */
+    DO_LABEL    *labels;
+    } DO_LABEL_INDEX;
+
+static DO_LABEL_INDEX sim_do_labels[DO_LABEL_FILES];
+static uint32 sim_do_labels_use = 0;
+
+static void do_label_free (DO_LABEL_INDEX *idx)
+{
+int32 i;
+
+for (i = 0; i < idx->count; i++) {
+    free (idx->labels[i].name);
+    free (idx->labels[i].text);
+    }
+free (idx->labels);
+memset (idx, 0, sizeof (*idx));
+}
+
+/* Return the label index for the open do file, building it if necessary.
+   Leaves the file position undefined; returns NULL if no index could be built */
+
+static DO_LABEL_INDEX *do_label_index (FILE *f, const char *filename)
+{
+struct stat fstat_s;
+DO_LABEL_INDEX *idx = NULL;
+DO_LABEL *lbl;
+char cbuf[CBUFSIZE], gbuf[CBUFSIZE];
+const char *cptr;
+int32 i, line;
+int32 saved_do_echo = sim_do_echo;
+
+if ((filename[0] == '\0') || fstat (fileno (f), &fstat_s))
+    return NULL;
+for (i = 0; i < DO_LABEL_FILES; i++) {                  /* find file, or LRU slot */
+    if (0 == strcmp (sim_do_labels[i].filename, filename)) {
+        idx = &sim_do_labels[i];
+        break;
+        }
+    if ((idx == NULL) || (sim_do_labels[i].lastuse < idx->lastuse))
+        idx = &sim_do_labels[i];
+    }
+idx->lastuse = ++sim_do_labels_use;
+if ((0 == strcmp (idx->filename, filename)) &&          /* indexed and unchanged? */
+    (idx->size == (t_offset)fstat_s.st_size) &&
+    (idx->mtime == fstat_s.st_mtime))
+    return idx;
+do_label_free (idx);                                    /* (re)build */
+rewind (f);
+sim_do_echo = 0;                                        /* Don't echo while scanning */
+for (line = 1; NULL != (cptr = read_line (cbuf, sizeof(cbuf), f)); line++) {
+    if (*cptr != ':') continue;                         /* ignore non-labels */
+    ++cptr;                                             /* skip : */
+    while (sim_isspace (*cptr)) ++cptr;                 /* skip blanks */
+    get_glyph (cptr, gbuf, 0);                          /* get label glyph */
+    if (idx->count == idx->alloc) {
+        idx->alloc = idx->alloc ? 2 * idx->alloc : 16;
+        lbl = (DO_LABEL *)realloc (idx->labels, idx->alloc * sizeof (*lbl));
+        if (lbl == NULL)
+            break;
+        idx->labels = lbl;
+        }
+    lbl = &idx->labels[idx->count];
+    lbl->name = strdup (gbuf);
+    lbl->text = strdup (cbuf);
+    lbl->fpos = ftell (f);
+    lbl->line = line;
+    if ((lbl->name == NULL) || (lbl->text == NULL) || (lbl->fpos < 0)) {
+        idx->count += 1;                                /* include partial entry in cleanup */
+        break;
+        }
+    idx->count += 1;
+    }
+sim_do_echo = saved_do_echo;                            /* restore echo mode */
+if (cptr != NULL) {                                     /* stopped early? */
+    do_label_free (idx);
+    return NULL;
+    }
+strlcpy (idx->filename, filename, sizeof (idx->filename));
+idx->size = (t_offset)fstat_s.st_size;
+idx->mtime = fstat_s.st_mtime;
+idx->lastuse = sim_do_labels_use;
+return idx;
+}
 
 t_stat goto_cmd (int32 flag, CONST char *fcptr)
 {
@@ -4978,6 +5142,8 @@ const char *cptr;
 long fpos;
 int32 saved_do_echo = sim_do_echo;
 int32 saved_goto_line = sim_goto_line[sim_do_depth];
+DO_LABEL_INDEX *idx;
+int32 i;
 
 if (NULL == sim_gotofile) return SCPE_UNK;              /* only valid inside of do_cmd */
 get_glyph (fcptr, gbuf1, 0);
@@ -4986,6 +5152,22 @@ if ('\0' == gbuf1[0])                                   /* unspecified goto targ
 fpos = ftell(sim_gotofile);                             /* Save start position */
 if (fpos < 0)
     return sim_messagef (SCPE_IERR, "goto ftell error: %s\n", strerror (errno));
+idx = do_label_index (sim_gotofile, sim_do_filename[sim_do_depth]);
+if (idx != NULL) {
+    for (i = 0; i < idx->count; i++) {
+        if ((0 == strcmp (idx->labels[i].name, gbuf1)) &&
+            (0 == fseek (sim_gotofile, idx->labels[i].fpos, SEEK_SET))) {
+            sim_goto_line[sim_do_depth] = idx->labels[i].line;
+            sim_brk_clract ();                          /* goto defangs current actions */
+            if (sim_do_echo)                            /* echo if -v */
+                sim_printf("%s> %s\n", do_position(), idx->labels[i].text);
+            return SCPE_OK;
+            }
+        }
+    if (fseek(sim_gotofile, fpos, SEEK_SET))            /* restore start position */
+        return sim_messagef (SCPE_IERR, "goto seek error: %s\n", strerror (errno));
+    return sim_messagef (SCPE_ARG, "goto target '%s' not found\n", gbuf1);
+    }
 rewind(sim_gotofile);                                   /* start search for label */
 sim_goto_line[sim_do_depth] = 0;                        /* reset line number */
 sim_do_echo = 0;                                        /* Don't echo while searching for label */
@@ -5656,7 +5838,7 @@ if (*cptr == 0) {                                       /* now eol? */
 GET_SWITCHES (cptr);                                    /* get more switches */
 
 while (*cptr != 0) {                                    /* do all mods */
-    cptr = get_glyph (cptr, gbuf, ',');                 /* get modifier */
+    cptr = get_glyph (svptr = cptr, gbuf, ',');         /* get modifier */
     if ((cvptr = strchr (gbuf, '=')))                   /* = value? */
         *cvptr++ = 0;
     for (mptr = dptr->modifiers; mptr && (mptr->mask != 0); mptr++) {
@@ -5667,6 +5849,11 @@ while (*cptr != 0) {                                    /* do all mods */
             )) {
             if (cvptr && !MODMASK(mptr,MTAB_SHP))
                 return sim_messagef (SCPE_ARG, "Invalid Argument: %s=%s\n", gbuf, cvptr);
+            if (cvptr && MODMASK(mptr,MTAB_NC)) {       /* value case matters? */
+                get_glyph_nc (svptr, gbuf, ',');
+                if ((cvptr = strchr (gbuf, '=')))
+                    *cvptr++ = 0;
+                }
             show_one_mod (ofile, dptr, uptr, mptr, cvptr, 1);
             break;
             }                                           /* end if */
@@ -8391,6 +8578,78 @@ if (sim_deb && (sim_deb != stdout) && (sim_deb != sim_log)) {/* debug if enabled
     }
 }
 
+/* Benchmark command
+
+   Executes the simulated program for a fixed number of instructions with
+   throttling and idling suspended and reports the instruction rate, the
+   host cost per instruction and the share of host time spent dispatching
+   events.  The output is a single line of name=value pairs so that results
+   can be collected by scripts and compared over time.
+
+   Host ticks are cycles where the host has a time stamp counter and
+   seconds otherwise, so host_cycles_per_instruction is only reported
+   when they are cycles.  Event time is scaled by the ratio of elapsed
+   seconds to elapsed ticks, which holds for either unit.
+*/
+
+#if defined (SIM_BENCH_TSC)
+#define sim_bench_ticks() ((double)__rdtsc ())          /* host cycles */
+#else
+#define sim_bench_ticks() sim_timenow_double ()         /* seconds */
+#endif
+
+#define SIM_BENCH_DFLT  100000000                       /* default instruction count */
+
+t_stat benchmark_cmd (int32 flag, CONST char *cptr)
+{
+char gbuf[CBUFSIZE];
+int32 count = SIM_BENCH_DFLT;
+double inst, secs, ticks, evt_secs;
+double inst_start, secs_start, ticks_start;
+t_stat r;
+
+GET_SWITCHES (cptr);                                    /* get switches */
+if (*cptr != 0) {                                       /* argument? */
+    cptr = get_glyph (cptr, gbuf, 0);                   /* get next glyph */
+    if (*cptr != 0)                                     /* should be end */
+        return SCPE_2MARG;
+    count = (int32) get_uint (gbuf, 10, INT_MAX, &r);
+    if ((r != SCPE_OK) || (count <= 0))                 /* error? */
+        return sim_messagef (SCPE_ARG, "Invalid instruction count: %s\n", gbuf);
+    }
+sim_switches &= ~SWMASK ('T');                          /* always instruction based */
+sprintf (gbuf, "%d", count);
+sim_bench_events = sim_bench_event_ticks = 0.0;
+sim_timer_set_benchmark (TRUE);                         /* suspend throttle and idle */
+sim_bench_active = TRUE;
+inst_start = sim_gtime ();
+secs_start = sim_timenow_double ();
+ticks_start = sim_bench_ticks ();
+r = run_cmd (RU_STEP, gbuf);
+ticks = sim_bench_ticks () - ticks_start;
+secs = sim_timenow_double () - secs_start;
+inst = sim_gtime () - inst_start;
+sim_bench_active = FALSE;
+sim_timer_set_benchmark (FALSE);                        /* restore throttle and idle */
+r = SCPE_BARE_STATUS (r);
+if ((r != SCPE_STEP) && (r != SCPE_OK))                 /* stopped early? */
+    run_cmd_message (NULL, r);                          /* say why */
+if (secs <= 0.0)
+    secs = 1.0e-9;
+if (ticks <= 0.0)
+    ticks = 1.0;
+evt_secs = (sim_bench_event_ticks * secs) / ticks;      /* event share of run, in seconds */
+sim_printf ("BENCHMARK: sim=\"%s\" instructions=%.0f seconds=%.6f mips=%.3f host_ns_per_instruction=%.2f",
+            sim_name, inst, secs, inst / (secs * 1000000.0), (inst > 0.0) ? (secs * 1.0e9) / inst : 0.0);
+#if defined (SIM_BENCH_TSC)
+sim_printf (" host_cycles_per_instruction=%.2f", (inst > 0.0) ? ticks / inst : 0.0);
+#endif
+sim_printf (" events=%.0f event_seconds=%.6f event_overhead_pct=%.2f stop=\"%s\"\n",
+            sim_bench_events, evt_secs, (100.0 * evt_secs) / secs,
+            (r >= SCPE_BASE) ? sim_error_text (r) : ((sim_stop_messages[r] != NULL) ? sim_stop_messages[r] : "Unknown"));
+return ((r == SCPE_STEP) || (r == SCPE_STOP) || (r < SCPE_BASE)) ? SCPE_OK : r;
+}
+
 /* Common setup for RUN or BOOT */
 
 t_stat sim_run_boot_prep (int32 flag)
@@ -11040,8 +11299,24 @@ return buf;
                         or 0 (SCPE_OK) if no exceptions
 */
 
+static t_stat _sim_process_event (void);
+
 t_stat sim_process_event (void)
 {
+double start;
+t_stat reason;
+
+if (!sim_bench_active)
+    return _sim_process_event ();
+start = sim_bench_ticks ();
+reason = _sim_process_event ();
+sim_bench_event_ticks += sim_bench_ticks () - start;
+sim_bench_events += 1.0;
+return reason;
+}
+
+static t_stat _sim_process_event (void)
+{
 UNIT *uptr;
 t_stat reason, bare_reason;
 
@@ -12788,6 +13063,8 @@ AIO_UNLOCK;
 
 static void _sim_debug_write (const char *buf, size_t len)
 {
+if (sim_deb == stdout)
+    sim_con_flush_output ();                            /* keep buffered console output in order */
 _sim_debug_write_flush (buf, len, FALSE);
 }
 
@@ -12809,7 +13086,7 @@ if (sim_deb == sim_log) {                               /* debug is log */
     return SCPE_OK;
     }
 
-if (!(saved_deb_switches & SWMASK ('B'))) {
+if (!(saved_deb_switches & (SWMASK ('B') | SWMASK ('X')))) {
     strcpy (saved_debug_filename, sim_logfile_name (sim_deb, sim_deb_ref));
 
     sim_quiet = 1;
@@ -12850,18 +13127,33 @@ while (dptr->debflags[offset].name && (offset < 32)) {
 return some_match ? some_match : debtab_nomatch;
 }
 
-/* Prints standard debug prefix unless previous call unterminated */
+/* Current PC value for debug output */
 
-static const char *sim_debug_prefix (uint32 dbits, DEVICE* dptr, UNIT* uptr)
+static t_value _sim_debug_pc (void)
+{
+/* Some simulators expose the PC as a register, some don't expose it or expose a register 
+   which is not a variable which is updated during instruction execution (i.e. only upon
+   exit of sim_instr()).  For the -P debug option to be effective, such a simulator should
+   provide a routine which returns the value of the current PC and set the sim_vm_pc_value
+   routine pointer to that routine.
+ */
+if (sim_vm_pc_value)
+    return (*sim_vm_pc_value)();
+return get_rval (sim_PC, 0);
+}
+
+/* Formats the standard debug prefix from the time and PC of the event */
+
+static const char *_sim_debug_prefix (uint32 dbits, DEVICE* dptr, UNIT* uptr, 
+                                      struct timespec time_now, double gtime, 
+                                      t_value val, t_bool main_thread)
 {
 const char* debug_type = _get_dbg_verb (dbits, dptr, uptr);
 char tim_t[32] = "";
 char tim_a[32] = "";
 char pc_s[64] = "";
-struct timespec time_now;
 
 if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A'))) {
-    clock_gettime(CLOCK_REALTIME, &time_now);
     if (sim_deb_switches & SWMASK ('R'))
         sim_timespec_diff (&time_now, &time_now, &sim_deb_basetime);
     if (sim_deb_switches & SWMASK ('T')) {
@@ -12875,25 +13167,27 @@ if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A'))) {
         }
     }
 if (sim_deb_switches & SWMASK ('P')) {
-    t_value val;
-    
-    /* Some simulators expose the PC as a register, some don't expose it or expose a register 
-       which is not a variable which is updated during instruction execution (i.e. only upon
-       exit of sim_instr()).  For the -P debug option to be effective, such a simulator should
-       provide a routine which returns the value of the current PC and set the sim_vm_pc_value
-       routine pointer to that routine.
-     */
-    if (sim_vm_pc_value)
-        val = (*sim_vm_pc_value)();
-    else
-        val = get_rval (sim_PC, 0);
     sprintf(pc_s, "-%s:", sim_PC->name);
     sprint_val (&pc_s[strlen(pc_s)], val, sim_PC->radix, sim_PC->width, sim_PC->flags & REG_FMT);
     }
-sprintf(debug_line_prefix, "DBG(%s%s%.0f%s)%s> %s %s: ", tim_t, tim_a, sim_gtime(), pc_s, AIO_MAIN_THREAD ? "" : "+", dptr->name, debug_type);
+sprintf(debug_line_prefix, "DBG(%s%s%.0f%s)%s> %s %s: ", tim_t, tim_a, gtime, pc_s, main_thread ? "" : "+", dptr->name, debug_type);
 return debug_line_prefix;
 }
 
+/* Prints standard debug prefix unless previous call unterminated */
+
+static const char *sim_debug_prefix (uint32 dbits, DEVICE* dptr, UNIT* uptr)
+{
+struct timespec time_now = {0, 0};
+t_value val = 0;
+
+if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A')))
+    clock_gettime(CLOCK_REALTIME, &time_now);
+if (sim_deb_switches & SWMASK ('P'))
+    val = _sim_debug_pc ();
+return _sim_debug_prefix (dbits, dptr, uptr, time_now, sim_gtime(), val, AIO_MAIN_THREAD);
+}
+
 void fprint_fields (FILE *stream, t_value before, t_value after, BITFIELD* bitdefs)
 {
 int32 i, fields, offset;
@@ -13001,6 +13295,7 @@ while (1) {                                         /* format passed string, arg
 if (sim_is_running) {
     char *c, *remnant = buf;
 
+    sim_con_flush_output ();                        /* keep buffered console output in order */
     while ((c = strchr (remnant, '\n'))) {
         if ((c != buf) && (*(c - 1) != '\r'))
             fprintf (stdout, "%.*s\r\n", (int)(c-remnant), remnant);
@@ -13114,6 +13409,450 @@ if (buf != stackbuf)
 return stat | ((stat != SCPE_OK) ? SCPE_NOMESSAGE : 0);
 }
 
+/* Output formatted debug data expanding newlines where they exist */
+
+static void _sim_debug_emit (const char *debug_prefix, const char *buf, int32 len)
+{
+int32 i, j;
+
+for (i = j = 0; i < len; ++i) {
+    if ('\n' == buf[i]) {
+        if (i >= j) {
+            if ((i != j) || (i == 0)) {
+                if (!debug_unterm)                      /* print prefix when required */
+                    _sim_debug_write (debug_prefix, strlen (debug_prefix));
+                _sim_debug_write (&buf[j], i-j);
+                _sim_debug_write ("\r\n", 2);
+                }
+            debug_unterm = 0;
+            }
+        j = i + 1;
+        }
+    else {
+        if (buf[i] == 0) {      /* Imbedded \0 character in formatted result? */
+            fprintf (stderr, "sim_debug() formatted result: '%s'\r\n"
+                             "            has an imbedded \\0 character.\r\n"
+                             "DON'T DO THAT!\r\n", buf);
+            abort();
+            }
+        }
+    }
+if (i > j) {
+    if (!debug_unterm)                                  /* print prefix when required */
+        _sim_debug_write (debug_prefix, strlen (debug_prefix));
+    _sim_debug_write (&buf[j], i-j);
+    }
+
+/* Set unterminated flag for next time */
+
+debug_unterm = len ? (((buf[len-1]=='\n')) ? 0 : 1) : debug_unterm;
+}
+
+/* Binary debug trace
+
+   SET DEBUG -X captures each sim_debug message as a fixed size record in
+   a circular memory buffer instead of formatting and writing it.  A record
+   holds the simulated time, the host time and PC (when those are being
+   displayed), the device, unit and debug bits, the format string and the
+   raw argument values.  String arguments are copied, since they often live
+   in static or stack buffers.  The records are rendered into the usual
+   text form, oldest first, when debug output is turned off.
+
+   The format string itself is only referenced, so it must be a literal,
+   as GCC_FMT_ATTR already encourages.  A format with no conversions is
+   copied instead.
+*/
+
+#define DTA_NONE        0                       /* no argument (%%) */
+#define DTA_INT         1                       /* int and promoted types */
+#define DTA_LONG        2                       /* long */
+#define DTA_LLONG       3                       /* long long */
+#define DTA_SIZE        4                       /* size_t, ptrdiff_t */
+#define DTA_DBL         5                       /* double */
+#define DTA_LDBL        6                       /* long double */
+#define DTA_PTR         7                       /* pointer (%p) */
+#define DTA_STR         8                       /* string, copied */
+#define DTA_NPTR        9                       /* %n pointer, skipped */
+
+#define DTR_MAIN        0x01                    /* from main thread */
+#define DTR_TRUNC       0x02                    /* arguments truncated */
+#define DTR_TEXT        0x04                    /* payload holds message text */
+
+#define DTR_PAYLOAD     176                     /* argument bytes per record */
+
+typedef union {
+    LL_TYPE         ll;
+    double          d;
+    void            *p;
+    } DTA_VAL;
+
+typedef struct {
+    double          gtime;                      /* simulated time */
+    struct timespec wall;                       /* host time, if displayed */
+    t_value         pc;                         /* PC, if displayed */
+    DEVICE          *dptr;
+    UNIT            *uptr;
+    const char      *fmt;                       /* message format */
+    uint32          dbits;                      /* debug bits */
+    uint16          len;                        /* payload bytes in use */
+    uint8           flags;
+    uint8           payload[DTR_PAYLOAD];       /* argument values */
+    } DEBTRC;
+
+static DEBTRC *sim_deb_trace = NULL;            /* trace ring */
+static size_t sim_deb_trace_count = 0;          /* records in ring */
+static size_t sim_deb_trace_next = 0;           /* next record to fill */
+static size_t sim_deb_trace_inuse = 0;          /* records filled */
+
+/* Parse the conversion specification at fmt (which points at a '%').
+   Copies the specification to spec and returns the argument type, the
+   number of '*' width/precision arguments which precede it, the precision
+   (-1 if none, -2 if given by the last '*' argument) and a pointer past
+   it. */
+
+static const char *_debug_trace_spec (const char *fmt, char *spec, size_t spec_size, int *type, int *stars, int *prec)
+{
+const char *start = fmt++;
+int lmod = 0;                                   /* 1=l, 2=ll, 3=z/t, 4=L */
+size_t len;
+
+*stars = 0;
+*prec = -1;
+while ((*fmt != '\0') && (strchr ("-+ #0'", *fmt) != NULL))
+    ++fmt;
+if (*fmt == '*') {
+    ++*stars;
+    ++fmt;
+    }
+else
+    while (isdigit (*fmt))
+        ++fmt;
+if (*fmt == '.') {
+    ++fmt;
+    if (*fmt == '*') {
+        ++*stars;
+        *prec = -2;
+        ++fmt;
+        }
+    else {
+        *prec = 0;
+        while (isdigit (*fmt))
+            *prec = (*prec * 10) + (*fmt++ - '0');
+        }
+    }
+switch (*fmt) {
+    case 'h':
+        if (*++fmt == 'h')
+            ++fmt;
+        break;
+    case 'l':
+        lmod = 1;
+        if (*++fmt == 'l') {
+            lmod = 2;
+            ++fmt;
+            }
+        break;
+    case 'q': case 'j':
+        lmod = 2;
+        ++fmt;
+        break;
+    case 'z': case 't':
+        lmod = 3;
+        ++fmt;
+        break;
+    case 'L':
+        lmod = 4;
+        ++fmt;
+        break;
+    case 'I':                                   /* Microsoft sizes */
+        ++fmt;
+        if ((fmt[0] == '6') && (fmt[1] == '4')) {
+            lmod = 2;
+            fmt += 2;
+            }
+        else
+            if ((fmt[0] == '3') && (fmt[1] == '2'))
+                fmt += 2;
+            else
+                lmod = 3;
+        break;
+    }
+switch (*fmt) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+        *type = (lmod == 1) ? DTA_LONG : (lmod == 2) ? DTA_LLONG : 
+                (lmod == 3) ? DTA_SIZE : DTA_INT;
+        break;
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+        *type = (lmod == 4) ? DTA_LDBL : DTA_DBL;
+        break;
+    case 's':
+        *type = DTA_STR;
+        break;
+    case 'p':
+        *type = DTA_PTR;
+        break;
+    case 'n':
+        *type = DTA_NPTR;
+        break;
+    default:
+        *type = DTA_NONE;
+        break;
+    }
+if (*fmt != '\0')
+    ++fmt;
+len = MIN ((size_t)(fmt - start), spec_size - 1);
+memcpy (spec, start, len);
+spec[len] = '\0';
+return fmt;
+}
+
+static void _sim_debug_trace_record (uint32 dbits, DEVICE* dptr, UNIT *uptr, const char* fmt, va_list arglist)
+{
+DEBTRC *rec;
+const char *cp = fmt;
+char spec[64];
+int type, stars, prec;
+DTA_VAL val;
+size_t len;
+
+AIO_LOCK;
+rec = &sim_deb_trace[sim_deb_trace_next];
+if (++sim_deb_trace_next == sim_deb_trace_count)
+    sim_deb_trace_next = 0;
+if (sim_deb_trace_inuse < sim_deb_trace_count)
+    ++sim_deb_trace_inuse;
+AIO_UNLOCK;
+rec->gtime = sim_gtime ();
+if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A')))
+    clock_gettime (CLOCK_REALTIME, &rec->wall);
+rec->pc = (sim_deb_switches & SWMASK ('P')) ? _sim_debug_pc () : 0;
+rec->dptr = dptr;
+rec->uptr = uptr;
+rec->fmt = fmt;
+rec->dbits = dbits;
+rec->flags = AIO_MAIN_THREAD ? DTR_MAIN : 0;
+rec->len = 0;
+if (strchr (fmt, '%') == NULL) {                /* plain text? */
+    len = strlen (fmt);
+    if (len >= DTR_PAYLOAD) {
+        len = DTR_PAYLOAD - 1;
+        rec->flags |= DTR_TRUNC;
+        }
+    memcpy (rec->payload, fmt, len);
+    rec->payload[len] = '\0';
+    rec->len = (uint16)(len + 1);
+    rec->flags |= DTR_TEXT;
+    return;
+    }
+while ((cp = strchr (cp, '%')) != NULL) {
+    cp = _debug_trace_spec (cp, spec, sizeof (spec), &type, &stars, &prec);
+    if (type == DTA_NONE)
+        continue;
+    if (rec->len + stars * sizeof (val) + ((type == DTA_STR) ? 1 : sizeof (val)) > DTR_PAYLOAD) {
+        rec->flags |= DTR_TRUNC;
+        break;
+        }
+    while (stars-- > 0) {
+        val.ll = va_arg (arglist, int);
+        if ((stars == 0) && (prec == -2))       /* precision argument? */
+            prec = (val.ll < 0) ? -1 : (int)val.ll;
+        memcpy (&rec->payload[rec->len], &val, sizeof (val));
+        rec->len += sizeof (val);
+        }
+    switch (type) {
+        case DTA_INT:
+            val.ll = va_arg (arglist, int);
+            break;
+        case DTA_LONG:
+            val.ll = va_arg (arglist, long);
+            break;
+        case DTA_LLONG:
+            val.ll = va_arg (arglist, LL_TYPE);
+            break;
+        case DTA_SIZE:
+            val.ll = (LL_TYPE)va_arg (arglist, size_t);
+            break;
+        case DTA_DBL:
+            val.d = va_arg (arglist, double);
+            break;
+        case DTA_LDBL:
+            val.d = (double)va_arg (arglist, long double);
+            break;
+        case DTA_PTR:
+        case DTA_NPTR:
+            val.p = va_arg (arglist, void *);
+            break;
+        case DTA_STR:
+            val.p = va_arg (arglist, char *);
+            if (val.p == NULL)
+                len = 6;
+            else {
+                if (prec < 0)
+                    len = strlen ((char *)val.p);
+                else                            /* may not be terminated */
+                    for (len = 0; (len < (size_t)prec) && ((char *)val.p)[len]; len++)
+                        ;
+                }
+            if (rec->len + len + 1 > DTR_PAYLOAD) {
+                len = DTR_PAYLOAD - 1 - rec->len;
+                rec->flags |= DTR_TRUNC;
+                }
+            memcpy (&rec->payload[rec->len], val.p ? (char *)val.p : "(null)", len);
+            rec->payload[rec->len + len] = '\0';
+            rec->len += (uint16)(len + 1);
+            if (rec->flags & DTR_TRUNC)
+                return;
+            continue;
+        default:
+            val.ll = 0;
+            break;
+        }
+    memcpy (&rec->payload[rec->len], &val, sizeof (val));
+    rec->len += sizeof (val);
+    }
+}
+
+/* Render a trace record's message into buf (grown as needed) */
+
+static void _debug_trace_append (char **buf, size_t *size, size_t *used, const char *data, size_t len)
+{
+if (*used + len + 4 > *size) {
+    *size = *used + len + 1024;
+    *buf = (char *)realloc (*buf, *size);
+    }
+memcpy (*buf + *used, data, len);
+*used += len;
+}
+
+static int32 _sim_debug_trace_format (const DEBTRC *rec, char **buf, size_t *size)
+{
+const char *cp = rec->fmt;
+const char *pct;
+char spec[64], nspec[128];
+char tmp[512];
+char *sp, *np;
+int type, stars, prec, len;
+size_t used = 0, off = 0;
+DTA_VAL val;
+
+if (rec->flags & DTR_TEXT)
+    _debug_trace_append (buf, size, &used, (const char *)rec->payload, strlen ((const char *)rec->payload));
+else {
+    while ((pct = strchr (cp, '%')) != NULL) {
+        _debug_trace_append (buf, size, &used, cp, pct - cp);
+        cp = _debug_trace_spec (pct, spec, sizeof (spec), &type, &stars, &prec);
+        if (type == DTA_NONE) {
+            if (spec[1] == '%')
+                _debug_trace_append (buf, size, &used, "%", 1);
+            else
+                _debug_trace_append (buf, size, &used, spec, strlen (spec));
+            continue;
+            }
+        if (off + stars * sizeof (val) + ((type == DTA_STR) ? 1 : sizeof (val)) > rec->len)
+            break;                              /* out of captured data */
+        for (sp = spec, np = nspec; *sp && (np < nspec + sizeof (nspec) - 12); ) {
+            if (*sp == '*') {                   /* substitute width/precision */
+                memcpy (&val, &rec->payload[off], sizeof (val));
+                off += sizeof (val);
+                np += sprintf (np, "%d", (int)val.ll);
+                ++sp;
+                }
+            else
+                *np++ = *sp++;
+            }
+        *np = '\0';
+        if (type == DTA_STR) {
+            len = snprintf (tmp, sizeof (tmp), nspec, (const char *)&rec->payload[off]);
+            off += strlen ((const char *)&rec->payload[off]) + 1;
+            }
+        else {
+            memcpy (&val, &rec->payload[off], sizeof (val));
+            off += sizeof (val);
+            switch (type) {
+                case DTA_INT:
+                    len = snprintf (tmp, sizeof (tmp), nspec, (int)val.ll);
+                    break;
+                case DTA_LONG:
+                    len = snprintf (tmp, sizeof (tmp), nspec, (long)val.ll);
+                    break;
+                case DTA_LLONG:
+                    len = snprintf (tmp, sizeof (tmp), nspec, (LL_TYPE)val.ll);
+                    break;
+                case DTA_SIZE:
+                    len = snprintf (tmp, sizeof (tmp), nspec, (size_t)val.ll);
+                    break;
+                case DTA_DBL:
+                    len = snprintf (tmp, sizeof (tmp), nspec, val.d);
+                    break;
+                case DTA_LDBL:
+                    len = snprintf (tmp, sizeof (tmp), nspec, (long double)val.d);
+                    break;
+                case DTA_PTR:
+                    len = snprintf (tmp, sizeof (tmp), nspec, val.p);
+                    break;
+                default:                        /* %n */
+                    len = 0;
+                    break;
+                }
+            }
+        len = MIN (MAX (len, 0), (int)sizeof (tmp) - 1);
+        _debug_trace_append (buf, size, &used, tmp, len);
+        }
+    if (pct == NULL)
+        _debug_trace_append (buf, size, &used, cp, strlen (cp));
+    }
+if (rec->flags & DTR_TRUNC)
+    _debug_trace_append (buf, size, &used, "...", 3);
+_debug_trace_append (buf, size, &used, "", 0);
+(*buf)[used] = '\0';
+return (int32)used;
+}
+
+t_stat sim_deb_trace_open (size_t size)
+{
+free (sim_deb_trace);
+sim_deb_trace_count = size / sizeof (*sim_deb_trace);
+sim_deb_trace = (DEBTRC *)calloc (sim_deb_trace_count, sizeof (*sim_deb_trace));
+sim_deb_trace_next = sim_deb_trace_inuse = 0;
+if (sim_deb_trace == NULL) {
+    sim_deb_trace_count = 0;
+    return SCPE_MEM;
+    }
+return SCPE_OK;
+}
+
+/* Render the trace records to the debug file and release the buffer */
+
+void sim_deb_trace_close (void)
+{
+const char *bufmsg = "Binary Trace Contents follow here:\n\n";
+size_t rec = (sim_deb_trace_inuse == sim_deb_trace_count) ? sim_deb_trace_next : 0;
+char *buf = NULL;
+size_t size = 0;
+int32 len;
+DEBTRC *tp;
+
+if (sim_deb_trace == NULL)
+    return;
+fwrite (bufmsg, 1, strlen (bufmsg), sim_deb);
+debug_unterm = 0;
+while (sim_deb_trace_inuse > 0) {
+    tp = &sim_deb_trace[rec];
+    len = _sim_debug_trace_format (tp, &buf, &size);
+    _sim_debug_emit (_sim_debug_prefix (tp->dbits, tp->dptr, tp->uptr, tp->wall, 
+                                        tp->gtime, tp->pc, (tp->flags & DTR_MAIN) != 0), 
+                     buf, len);
+    --sim_deb_trace_inuse;
+    if (++rec == sim_deb_trace_count)
+        rec = 0;
+    }
+_sim_debug_write_flush ("", 0, TRUE);
+free (buf);
+free (sim_deb_trace);
+sim_deb_trace = NULL;
+sim_deb_trace_count = sim_deb_trace_next = 0;
+}
+
 /* Inline debugging - will print debug message if debug file is
    set and the bitmask matches the current device debug options.
    Extra returns are added for un*x systems, since the output
@@ -13129,9 +13868,14 @@ if (sim_deb && dptr && ((dptr->dctrl | (uptr ? uptr->dctrl : 0)) & dbits)) {
     char stackbuf[STACKBUFSIZE];
     int32 bufsize = sizeof(stackbuf);
     char *buf = stackbuf;
-    int32 i, j, len;
-    const char* debug_prefix = sim_debug_prefix(dbits, dptr, uptr);   /* prefix to print if required */
+    int32 len;
+    const char* debug_prefix;
 
+    if (sim_deb_trace) {                                /* binary trace? */
+        _sim_debug_trace_record (dbits, dptr, uptr, fmt, arglist);
+        return;
+        }
+    debug_prefix = sim_debug_prefix(dbits, dptr, uptr); /* prefix to print if required */
     sim_oline = NULL;                                   /* avoid potential debug to active socket */
     buf[bufsize-1] = '\0';
 
@@ -13159,39 +13903,7 @@ if (sim_deb && dptr && ((dptr->dctrl | (uptr ? uptr->dctrl : 0)) & dbits)) {
         break;
         }
 
-/* Output the formatted data expanding newlines where they exist */
-
-    for (i = j = 0; i < len; ++i) {
-        if ('\n' == buf[i]) {
-            if (i >= j) {
-                if ((i != j) || (i == 0)) {
-                    if (!debug_unterm)                  /* print prefix when required */
-                        _sim_debug_write (debug_prefix, strlen (debug_prefix));
-                    _sim_debug_write (&buf[j], i-j);
-                    _sim_debug_write ("\r\n", 2);
-                    }
-                debug_unterm = 0;
-                }
-            j = i + 1;
-            }
-        else {
-            if (buf[i] == 0) {      /* Imbedded \0 character in formatted result? */
-                fprintf (stderr, "sim_debug() formatted result: '%s'\r\n"
-                                 "            has an imbedded \\0 character.\r\n"
-                                 "DON'T DO THAT!\r\n", buf);
-                abort();
-                }
-            }
-        }
-    if (i > j) {
-        if (!debug_unterm)                          /* print prefix when required */
-            _sim_debug_write (debug_prefix, strlen (debug_prefix));
-        _sim_debug_write (&buf[j], i-j);
-        }
-
-/* Set unterminated flag for next time */
-
-    debug_unterm = len ? (((buf[len-1]=='\n')) ? 0 : 1) : debug_unterm;
+    _sim_debug_emit (debug_prefix, buf, len);
     if (buf != stackbuf)
         free (buf);
     sim_oline = saved_oline;                            /* restore original socket */
@@ -14985,6 +15697,7 @@ if (sim_switches & SWMASK ('D')) {
     sim_set_debon (0, "STDOUT");
     sim_switches = saved_switches;
     }
+stat = sim_fio_test ((saved_switches & SWMASK ('B')) != 0);
 for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
     t_stat tstat = SCPE_OK;
 
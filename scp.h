@@ -117,6 +117,7 @@ t_stat echo_cmd (int32 flag, CONST char *ptr);
 t_stat echof_cmd (int32 flag, CONST char *ptr);
 t_stat debug_cmd (int32 flag, CONST char *ptr);
 t_stat runlimit_cmd (int32 flag, CONST char *ptr);
+t_stat benchmark_cmd (int32 flag, CONST char *ptr);
 
 /* Allow compiler to help validate printf style format arguments */
 #if !defined __GNUC__
@@ -375,6 +376,8 @@ extern size_t sim_deb_buffer_size;                      /* debug memory buffer s
 extern char *sim_deb_buffer;                            /* debug memory buffer */
 extern size_t sim_debug_buffer_offset;                  /* debug memory buffer insertion offset */
 extern size_t sim_debug_buffer_inuse;                   /* debug memory buffer inuse count */
+t_stat sim_deb_trace_open (size_t size);
+void sim_deb_trace_close (void);
 extern struct timespec sim_deb_basetime;                /* debug base time for relative time output */
 extern DEVICE **sim_internal_devices;
 extern uint32 sim_internal_device_count;
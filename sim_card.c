@@ -73,9 +73,38 @@
 
 #define CARD_EOF          0x1000         /* This card is end of file card. */
 #define CARD_ERR          0x2000         /* Return error for this card */
-#define DECK_SIZE         1000           /* Number of cards to allocate at a time */
+#define CARD_MADE         0x4000         /* EOF card added by -E, not in file */
+#define DECK_SIZE         1000           /* Number of cards to allocate at first */
+#define HOPPER_AHEAD      64             /* Cards parsed ahead of the reader */
 
 
+struct _card_buffer {
+   uint8                 buffer[8192+500];    /* Buffer data */
+   int                   len;                 /* Amount of data in buffer */
+   int                   start;               /* Start of current card */
+   int                   size;                /* Size of last card read */
+   t_offset              base;                /* File offset of buffer[0] */
+   int                   deck;                /* Deck buffer holds, -1 if none */
+};
+
+/* The input hopper does not hold card images.  At attach each deck is
+   scanned once to find where its cards start, and the file is kept open.
+   Cards are then parsed again, HOPPER_AHEAD at a time, as the reader
+   gets to them. */
+
+struct card_deck
+{
+    FILE               *fileref;         /* Open deck file */
+    uint32              flags;           /* Unit format flags at attach */
+};
+
+struct card_index
+{
+    t_offset            offset;          /* File offset of card */
+    uint16              deck;            /* Deck holding card */
+    uint16              flags;           /* CARD_EOF, CARD_ERR, CARD_MADE */
+};
+
 struct card_context
 {
     t_addr              punch_count;     /* Number of cards punched */
@@ -83,9 +112,17 @@ struct card_context
     uint8               hol_to_ascii[4096]; /* Back conversion table */
     t_addr              hopper_size;     /* Size of hopper */
     t_addr              hopper_cards;    /* Number of cards in hopper */
-    uint16              (*images)[1][80];
+    struct card_index   *cards;          /* Where each card in hopper is */
+    int                 decks;           /* Number of decks stacked */
+    struct card_deck    *deck;           /* Decks stacked in hopper */
+    t_addr              ahead_first;     /* First card parsed ahead */
+    t_addr              ahead_cards;     /* Number of cards parsed ahead */
+    uint16              ahead[HOPPER_AHEAD][80]; /* Cards parsed ahead */
+    struct _card_buffer *rbuf;           /* Buffer for parsing ahead */
 };
 
+static t_stat _sim_parse_card(DEVICE *dptr, struct _card_buffer *buf, uint32 flags, uint16 (*image)[80]);
+
 /* Character conversion tables */
 
 const char          sim_six_to_ascii[64] = {
@@ -479,6 +516,90 @@ sim_hol_to_ebcdic(uint16 hol) {
 
 
 
+/*
+ * Make sure at least 500 bytes past the current card are in the buffer.
+ */
+static t_stat
+_sim_fill_card_buffer(struct _card_buffer *buf, FILE *fileref)
+{
+    size_t                l;
+
+    if (buf->len - buf->start >= 500 || feof(fileref))
+        return SCPE_OK;
+    /* Move unused data down to the start of the buffer */
+    buf->len -= buf->start;
+    memmove(&buf->buffer[0], &buf->buffer[buf->start], buf->len);
+    buf->base += buf->start;
+    buf->start = 0;
+    l = sim_fread(&buf->buffer[buf->len], 1, 8192, fileref);
+    if (ferror(fileref))
+        return SCPE_OPENERR;
+    buf->len += (int)l;
+    return SCPE_OK;
+}
+
+/*
+ * Parse the cards from the read position on into the look ahead window.
+ */
+static void
+_sim_card_ahead(UNIT *uptr, DEVICE *dptr)
+{
+    struct card_context  *data = (struct card_context *)uptr->card_ctx;
+    struct _card_buffer  *buf = data->rbuf;
+    struct card_index    *card;
+    struct card_deck     *deck;
+    t_addr                n;
+
+    data->ahead_first = uptr->pos;
+    for (n = 0; n < HOPPER_AHEAD && uptr->pos + n < data->hopper_cards; n++) {
+        card = &data->cards[uptr->pos + n];
+        memset(data->ahead[n], 0, sizeof(data->ahead[n]));
+        if (card->flags & CARD_MADE) {
+            data->ahead[n][0] = CARD_EOF;
+            continue;
+        }
+        deck = &data->deck[card->deck];
+        /* Seek unless card follows the last one parsed */
+        if (buf->deck != card->deck || buf->base + buf->start != card->offset) {
+            buf->len = buf->start = buf->size = 0;
+            buf->base = card->offset;
+            buf->deck = -1;
+            if (sim_fseeko(deck->fileref, card->offset, SEEK_SET) != 0) {
+                data->ahead[n][0] = CARD_ERR;
+                continue;
+            }
+            buf->deck = card->deck;
+        }
+        if (_sim_fill_card_buffer(buf, deck->fileref) != SCPE_OK ||
+            _sim_parse_card(dptr, buf, deck->flags, &data->ahead[n]) != SCPE_OK)
+            data->ahead[n][0] |= CARD_ERR;
+        buf->start += buf->size;
+    }
+    data->ahead_cards = n;
+}
+
+/*
+ * Empty the input hopper and close the decks in it.
+ */
+static void
+_sim_card_empty(struct card_context *data)
+{
+    int                   i;
+
+    for (i = 0; i < data->decks; i++)
+        fclose(data->deck[i].fileref);
+    free(data->deck);
+    data->deck = NULL;
+    data->decks = 0;
+    free(data->cards);
+    data->cards = NULL;
+    data->hopper_cards = 0;
+    data->hopper_size = 0;
+    data->ahead_cards = 0;
+    if (data->rbuf != NULL)
+        data->rbuf->deck = -1;
+}
+
 t_addr
 sim_hopper_size(UNIT * uptr) {
     struct card_context  *data = (struct card_context *)uptr->card_ctx;
@@ -500,13 +621,13 @@ sim_card_input_hopper_count(UNIT *uptr) {
     struct card_context  *data = (struct card_context *)uptr->card_ctx;
     uint16                col;
 
-    if (data == NULL || data->images == NULL)
+    if (data == NULL || data->cards == NULL)
         return 0;           /* attached? */
 
     if (uptr->pos >= data->hopper_cards)
         return 0;
 
-    col = (*data->images)[data->hopper_cards-1][0];
+    col = data->cards[data->hopper_cards-1].flags;
 
     return (int)((data->hopper_cards - uptr->pos) - ((col & CARD_EOF) ? 1 : 0));
 }
@@ -537,7 +658,10 @@ sim_read_card(UNIT * uptr, uint16 image[80])
         return CDSE_EMPTY;
 
     dptr = find_dev_from_unit( uptr);
-    img = &(*data->images)[uptr->pos];
+    if (uptr->pos < data->ahead_first ||
+        uptr->pos >= data->ahead_first + data->ahead_cards)
+        _sim_card_ahead(uptr, dptr);
+    img = &data->ahead[uptr->pos - data->ahead_first];
     if (sim_deb && dptr && ((dptr)->dctrl & DEBUG_CARD)) {
          if (image[0] & CARD_EOF) {
              sim_debug(DEBUG_CARD, dptr, "Read hopper EOF\n");
@@ -583,13 +707,13 @@ sim_card_eof(UNIT *uptr)
     struct card_context  *data = (struct card_context *)uptr->card_ctx;
     uint16                col;
 
-    if (data == NULL || data->images == NULL)
+    if (data == NULL || data->cards == NULL)
         return SCPE_UNATT;      /* attached? */
 
     if (uptr->pos >= data->hopper_cards)
         return SCPE_UNATT;
 
-    col = (*data->images)[uptr->pos][0];
+    col = data->cards[uptr->pos].flags;
 
     if (col & CARD_EOF)
         return 1;
@@ -597,13 +721,6 @@ sim_card_eof(UNIT *uptr)
 }
 
 
-
-struct _card_buffer {
-   uint8                 buffer[8192+500];    /* Buffer data */
-   int                   len;                 /* Amount of data in buffer */
-   int                   size;                /* Size of last card read */
-};
-
 static int _cmpcard(const uint8 *p, const char *s) {
    int  i;
    if (p[0] != '~')
@@ -615,8 +732,10 @@ static int _cmpcard(const uint8 *p, const char *s) {
    return 1;
 }
 
-t_stat
-_sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*image)[80]) {
+static t_stat
+_sim_parse_card(DEVICE *dptr, struct _card_buffer *buf, uint32 flags, uint16 (*image)[80]) {
+    uint8                *cbuf = &buf->buffer[buf->start];
+    int                   len = buf->len - buf->start;
     int                   mode;
     uint16                temp;
     int                   i;
@@ -624,25 +743,25 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
     int                   col;
 
     sim_debug(DEBUG_CARD, dptr, "Read card ");
-    if ((uptr->flags & UNIT_CARD_MODE) == MODE_AUTO) {
+    if ((flags & UNIT_CARD_MODE) == MODE_AUTO) {
         mode = MODE_TEXT;   /* Default is text */
 
         /* Check buffer to see if binary card in it. */
-        for (i = 0, temp = 0; i < 160 && i <buf->len; i+=2)
-            temp |= (uint16)(buf->buffer[i] & 0xFF);
+        for (i = 0, temp = 0; i < 160 && i <len; i+=2)
+            temp |= (uint16)(cbuf[i] & 0xFF);
         /* Check if every other char < 16 & full buffer */
         if ((temp & 0x0f) == 0 && i == 160)
             mode = MODE_BIN;        /* Probably binary */
         /* Check if maybe BCD or CBN */
-        if (buf->buffer[0] & 0x80) {
+        if (cbuf[0] & 0x80) {
             int     odd = 0;
             int     even = 0;
 
             /* Clear record mark */
-            buf->buffer[0] &= 0x7f;
+            cbuf[0] &= 0x7f;
             /* Check all chars for correct parity */
-            for(i = 0, temp = 0; i < buf->len; i++) {
-               uint8        ch = buf->buffer[i];
+            for(i = 0, temp = 0; i < len; i++) {
+               uint8        ch = cbuf[i];
                /* Stop at EOR */
                if (ch & 0x80)
                    break;
@@ -653,7 +772,7 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
                     odd++;
            }
            /* Restore it */
-           buf->buffer[0] |= 0x80;
+           cbuf[0] |= 0x80;
            if (i == 160 && odd == i)
                mode = MODE_CBN;
            else if (i < 80 && even == i)
@@ -661,24 +780,24 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
         }
 
         /* Check if modes match */
-        if ((uptr->flags & UNIT_CARD_MODE) != MODE_AUTO &&
-            (uptr->flags & UNIT_CARD_MODE) != mode) {
+        if ((flags & UNIT_CARD_MODE) != MODE_AUTO &&
+            (flags & UNIT_CARD_MODE) != mode) {
             (*image)[0] = CARD_ERR;
             sim_debug(DEBUG_CARD, dptr, "invalid mode\n");
             return SCPE_OPENERR;
         }
     } else
-        mode = uptr->flags & UNIT_CARD_MODE;
+        mode = flags & UNIT_CARD_MODE;
 
     switch(mode) {
     default:
     case MODE_TEXT:
         sim_debug(DEBUG_CARD, dptr, "text: [");
         /* Check for special codes */
-        if (buf->buffer[0] == '~') {
+        if (cbuf[0] == '~') {
             int f = 1;
-            for(col = i = 1; col < 80 && f && i < buf->len; i++) {
-                c = buf->buffer[i];
+            for(col = i = 1; col < 80 && f && i < len; i++) {
+                c = cbuf[i];
                 switch (c) {
                 case '\n':
                 case '\0':
@@ -699,14 +818,14 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
                 goto end_card;
              }
         }
-        if (_cmpcard(&buf->buffer[0], "raw")) {
+        if (_cmpcard(&cbuf[0], "raw")) {
             int         j = 0;
             sim_debug(DEBUG_CARD, dptr, "-octal-");
-            for(col = 0, i = 4; col < 80 && i < buf->len; i++) {
-                if (buf->buffer[i] >= '0' && buf->buffer[i] <= '7') {
-                    (*image)[col] = ((*image)[col] << 3) | (buf->buffer[i] - '0');
+            for(col = 0, i = 4; col < 80 && i < len; i++) {
+                if (cbuf[i] >= '0' && cbuf[i] <= '7') {
+                    (*image)[col] = ((*image)[col] << 3) | (cbuf[i] - '0');
                     j++;
-                } else if (buf->buffer[i] == '\n' || buf->buffer[i] == '\r') {
+                } else if (cbuf[i] == '\n' || cbuf[i] == '\r') {
                     break;
                 } else {
                     (*image)[0] = CARD_ERR;
@@ -717,22 +836,22 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
                    j = 0;
                 }
             }
-        } else if (_cmpcard(&buf->buffer[0], "eor")) {
+        } else if (_cmpcard(&cbuf[0], "eor")) {
             sim_debug(DEBUG_CARD, dptr, "-eor-");
             (*image)[0] = 07;        /* 7/8/9 punch */
             i = 4;
-        } else if (_cmpcard(&buf->buffer[0], "eof")) {
+        } else if (_cmpcard(&cbuf[0], "eof")) {
             sim_debug(DEBUG_CARD, dptr, "-eof-");
             (*image)[0] = 015;       /* 6/7/9 punch */
             i = 4;
-        } else if (_cmpcard(&buf->buffer[0], "eoi")) {
+        } else if (_cmpcard(&cbuf[0], "eoi")) {
             sim_debug(DEBUG_CARD, dptr, "-eoi-");
             (*image)[0] = 017;       /* 6/7/8/9 punch */
             i = 4;
         } else {
             /* Convert text line into card image */
-            for (col = 0, i = 0; col < 80 && i < buf->len; i++) {
-                c = buf->buffer[i];
+            for (col = 0, i = 0; col < 80 && i < len; i++) {
+                c = cbuf[i];
                 switch (c) {
                 case '\0':
                 case '\r':
@@ -746,9 +865,9 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
                     break;
                 default:
                     sim_debug(DEBUG_CARD, dptr, "%c", c);
-                    if ((uptr->flags & MODE_LOWER) == 0)
+                    if ((flags & MODE_LOWER) == 0)
                         c = toupper(c);
-                    switch(uptr->flags & MODE_CHAR) {
+                    switch(flags & MODE_CHAR) {
                     default:
                     case MODE_026:
                            temp = ascii_to_hol_026[(int)c];
@@ -770,12 +889,12 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
         sim_debug(DEBUG_CARD, dptr, "-%d-", i);
 
         /* Scan to end of line, ignore anything after last column */
-        while (buf->buffer[i] != '\n' && buf->buffer[i] != '\r' && i < buf->len) {
+        while (cbuf[i] != '\n' && cbuf[i] != '\r' && i < len) {
             i++;
         }
-        if (buf->buffer[i] == '\r')
+        if (cbuf[i] == '\r')
             i++;
-        if (buf->buffer[i] == '\n')
+        if (cbuf[i] == '\n')
             i++;
         sim_debug(DEBUG_CARD, dptr, "]\n");
         break;
@@ -783,15 +902,15 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
     case MODE_BIN:
         temp = 0;
         sim_debug(DEBUG_CARD, dptr, "bin\n");
-        if (buf->len < 160) {
+        if (len < 160) {
             (*image)[0] = CARD_ERR;
             return SCPE_OPENERR;
         }
         /* Move data to buffer */
         for (col = i = 0; i < 160;) {
-            temp |= (uint16)(buf->buffer[i] & 0xff);
-            (*image)[col] = (buf->buffer[i++] >> 4) & 0xF;
-            (*image)[col++] |= ((uint16)buf->buffer[i++] & 0xf) << 4;
+            temp |= (uint16)(cbuf[i] & 0xff);
+            (*image)[col] = (cbuf[i++] >> 4) & 0xF;
+            (*image)[col++] |= ((uint16)cbuf[i++] & 0xf) << 4;
         }
         /* Check if format error */
         if (temp & 0xF)
@@ -802,40 +921,40 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
     case MODE_CBN:
         sim_debug(DEBUG_CARD, dptr, "cbn\n");
         /* Check if first character is a tape mark */
-        if (buf->buffer[0] == 0217 &&
-                   (buf->len == 1 || (buf->buffer[1] & 0200) != 0)) {
+        if (cbuf[0] == 0217 &&
+                   (len == 1 || (cbuf[1] & 0200) != 0)) {
             i = 1;
             (*image)[0] |= CARD_EOF;
             break;
         }
 
         /* Clear record mark */
-        buf->buffer[0] &= 0x7f;
+        cbuf[0] &= 0x7f;
 
         /* Convert card and check for errors */
-        for (col = i = 0; i < buf->len && col < 80;) {
+        for (col = i = 0; i < len && col < 80;) {
             uint8       c;
 
-            if (buf->buffer[i] & 0x80)
+            if (cbuf[i] & 0x80)
                 break;
-            c = buf->buffer[i] & 077;
-            if (sim_parity_table[(int)c] == (buf->buffer[i++] & 0100))
+            c = cbuf[i] & 077;
+            if (sim_parity_table[(int)c] == (cbuf[i++] & 0100))
                 (*image)[0] |= CARD_ERR;
             (*image)[col] = ((uint16)c) << 6;
-            if (buf->buffer[i] & 0x80)
+            if (cbuf[i] & 0x80)
                 break;
-            c = buf->buffer[i] & 077;
-            if (sim_parity_table[(int)c] == (buf->buffer[i++] & 0100))
+            c = cbuf[i] & 077;
+            if (sim_parity_table[(int)c] == (cbuf[i++] & 0100))
                 (*image)[0] |= CARD_ERR;
             (*image)[col++] |= c;
         }
 
-        if (i < buf->len && col >= 80 && (buf->buffer[i] & 0x80) == 0) {
+        if (i < len && col >= 80 && (cbuf[i] & 0x80) == 0) {
            (*image)[0] |= CARD_ERR;
         }
         /* Record over length of card, skip until next */
-        while ((buf->buffer[i] & 0x80) == 0) {
-            if (i > buf->len)
+        while ((cbuf[i] & 0x80) == 0) {
+            if (i > len)
                break;
             i++;
         }
@@ -844,34 +963,34 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
     case MODE_BCD:
         sim_debug(DEBUG_CARD, dptr, "bcd [");
         /* Check if first character is a tape mark */
-        if (buf->buffer[0] == 0217 && (buf->buffer[1] & 0200) != 0) {
+        if (cbuf[0] == 0217 && (cbuf[1] & 0200) != 0) {
             i = 1;
             (*image)[0] |= CARD_EOF;
             break;
         }
 
         /* Clear record mark */
-        buf->buffer[0] &= 0x7f;
+        cbuf[0] &= 0x7f;
 
         /* Convert text line into card image */
-        for (col = 0, i = 0; col < 80 && i < buf->len; i++) {
-            if (buf->buffer[i] & 0x80)
+        for (col = 0, i = 0; col < 80 && i < len; i++) {
+            if (cbuf[i] & 0x80)
                 break;
-            c = buf->buffer[i] & 077;
-            if (sim_parity_table[(int)c] != (buf->buffer[i] & 0100))
+            c = cbuf[i] & 077;
+            if (sim_parity_table[(int)c] != (cbuf[i] & 0100))
                 (*image)[0] |= CARD_ERR;
             sim_debug(DEBUG_CARD, dptr, "%c", sim_six_to_ascii[(int)c]);
             /* Convert to top column */
             (*image)[col++] = sim_bcd_to_hol(c);
         }
 
-        if (i < buf->len && col >= 80 && (buf->buffer[i] & 0x80) == 0) {
+        if (i < len && col >= 80 && (cbuf[i] & 0x80) == 0) {
            (*image)[0] |= CARD_ERR;
         }
 
         /* Record over length of card, skip until next */
-        while ((buf->buffer[i] & 0x80) == 0) {
-            if (i > buf->len)
+        while ((cbuf[i] & 0x80) == 0) {
+            if (i > len)
                break;
             i++;
         }
@@ -881,11 +1000,11 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
 
     case MODE_EBCDIC:
         sim_debug(DEBUG_CARD, dptr, "ebcdic\n");
-        if (buf->len < 80)
+        if (len < 80)
             (*image)[0] |= CARD_ERR;
         /* Move data to buffer */
-        for (i = 0; i < 80 && i < buf->len; i++) {
-            temp = (uint16)(buf->buffer[i]) & 0xFF;
+        for (i = 0; i < 80 && i < len; i++) {
+            temp = (uint16)(cbuf[i]) & 0xFF;
             (*image)[i] = ebcdic_to_hol[temp];
         }
         break;
@@ -900,10 +1019,11 @@ _sim_read_deck(UNIT * uptr, int eof)
 {
     struct _card_buffer   buf;
     struct card_context  *data;
+    struct card_index    *card;
     DEVICE               *dptr;
-    int                   i;
-    int                   j;
-    int                   l;
+    uint16                image[80];
+    t_addr                first;
+    int                   deck;
     int                   cards = 0;
     t_stat                r = SCPE_OK;
 
@@ -912,70 +1032,76 @@ _sim_read_deck(UNIT * uptr, int eof)
 
     dptr = find_dev_from_unit( uptr);
     data = (struct card_context *)uptr->card_ctx;
+    first = data->hopper_cards;
+    deck = data->decks;
 
     buf.len = 0;
+    buf.start = 0;
     buf.size = 0;
+    buf.base = 0;
     buf.buffer[0] = 0; /* Initialize bufer to empty */
 
-    /* Slurp up current file */
+    /* Find where each card of the file starts */
     do {
-        if (buf.len < 500 && !feof(uptr->fileref)) {
-            l = sim_fread(&buf.buffer[buf.len], 1, 8192, uptr->fileref);
-            if (l < 0)
-                r = SCPE_OPENERR;
-            else
-                buf.len += l;
-        }
+        if (_sim_fill_card_buffer(&buf, uptr->fileref) != SCPE_OK)
+            r = SCPE_OPENERR;
 
         /* Allocate space for some more cards if needed */
         if (data->hopper_cards >= data->hopper_size) {
-            data->hopper_size += DECK_SIZE;
-            data->images = (uint16 (*)[1][80])realloc(data->images,
-                       (size_t)data->hopper_size * sizeof(*(data->images)));
-            memset(&data->images[data->hopper_cards], 0,
-                       (size_t)(data->hopper_size - data->hopper_cards) *
-                             sizeof(*(data->images)));
+            data->hopper_size = (data->hopper_size == 0) ? DECK_SIZE :
+                                        2 * data->hopper_size;
+            data->cards = (struct card_index *)realloc(data->cards,
+                       (size_t)data->hopper_size * sizeof(*(data->cards)));
         }
 
         /* Process one card */
         cards++;
-        if (_sim_parse_card(uptr, dptr, &buf, &(*data->images)[data->hopper_cards])
-                != SCPE_OK) {
+        card = &data->cards[data->hopper_cards];
+        card->offset = buf.base + buf.start;
+        card->deck = (uint16)deck;
+        memset(image, 0, sizeof(image));
+        if (_sim_parse_card(dptr, &buf, uptr->flags, &image) != SCPE_OK) {
             r = sim_messagef(SCPE_OPENERR, "%s: %s Error (%s) in card %d\n",
                    sim_uname(uptr), uptr->filename, sim_error_text(r), cards);
         }
+        card->flags = image[0] & (CARD_EOF|CARD_ERR);
         data->hopper_cards++;
-        /* Move data to start at begining of buffer */
-        /* Data is moved down to simplify the decoding of one card */
-        l = buf.len - buf.size;
-        j = buf.size;
-        for(i = 0; i < l; i++, j++)
-            buf.buffer[i] = buf.buffer[j];
-        buf.len -= buf.size;
-    } while (buf.len > 0 && r == SCPE_OK);
+        buf.start += buf.size;
+    } while (buf.len > buf.start && r == SCPE_OK);
 
     /* If there is an error, free just read deck */
-    if (r == SCPE_OK) {
-       if (eof) {
-          /* Allocate space for some more cards if needed */
-          if (data->hopper_cards >= data->hopper_size) {
-              data->hopper_size += DECK_SIZE;
-              data->images = (uint16 (*)[1][80])realloc(data->images,
-                         (size_t)data->hopper_size * sizeof(*(data->images)));
-              memset(&data->images[data->hopper_cards], 0,
-                         (size_t)(data->hopper_size - data->hopper_cards) *
-                               sizeof(*(data->images)));
-          }
-
-          /* Create empty card */
-          (*data->images)[data->hopper_cards][0] = CARD_EOF;
-          data->hopper_cards++;
-       }
+    if (r != SCPE_OK) {
+        data->hopper_cards = first;
+        return r;
     }
+
+    if (eof) {
+        /* Allocate space for some more cards if needed */
+        if (data->hopper_cards >= data->hopper_size) {
+            data->hopper_size = 2 * data->hopper_size;
+            data->cards = (struct card_index *)realloc(data->cards,
+                       (size_t)data->hopper_size * sizeof(*(data->cards)));
+        }
+
+        /* Create empty card */
+        card = &data->cards[data->hopper_cards];
+        card->offset = 0;
+        card->deck = (uint16)deck;
+        card->flags = CARD_EOF|CARD_MADE;
+        data->hopper_cards++;
+    }
+
+    /* Keep the file open so its cards can be read later */
+    data->deck = (struct card_deck *)realloc(data->deck,
+                       (size_t)(deck + 1) * sizeof(*(data->deck)));
+    data->deck[deck].fileref = uptr->fileref;
+    data->deck[deck].flags = uptr->flags;
+    data->decks++;
+    uptr->fileref = NULL;
     return r;
 }
 
-
+
 /* Card punch routine
 
    Modifiers have been checked by the caller
@@ -1279,18 +1405,25 @@ sim_card_attach(UNIT * uptr, CONST char *cptr)
         /* Check if we should append to end of existing */
         if ((sim_switches & SWMASK ('S')) == 0) {
            previous_cards = 0;
-           data->hopper_cards = 0;
-           data->hopper_size = 0;
+           _sim_card_empty(data);
            data->punch_count = 0;
-           free(data->images);
-           data->images = NULL;
            free(saved_filename);
            saved_filename = NULL;
            saved_pos = 0;
         }
 
+        /* Allocate the look ahead buffer if one does not exist */
+        if (data->rbuf == NULL) {
+            data->rbuf = (struct _card_buffer *)calloc(1, sizeof(*data->rbuf));
+            if (data->rbuf != NULL)
+                data->rbuf->deck = -1;
+        }
+
         /* Go read the deck */
-        r = _sim_read_deck(uptr, eof);
+        if (data->rbuf == NULL)
+            r = SCPE_MEM;
+        else
+            r = _sim_read_deck(uptr, eof);
         uptr->pos = saved_pos;
         detach_unit(uptr);
         if (was_attached) {
@@ -1337,7 +1470,8 @@ sim_card_detach(UNIT * uptr)
     if (uptr->card_ctx != 0) {
         struct card_context * data = (struct card_context *)uptr->card_ctx;
         /* No clear any existing decks on stack */
-        free(data->images);
+        _sim_card_empty(data);
+        free(data->rbuf);
         free(uptr->card_ctx);
         uptr->card_ctx = 0;
     }
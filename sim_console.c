@@ -91,6 +91,7 @@
    sim_poll_kbd                 poll for keyboard input
    sim_putchar                  output character to console
    sim_putchar_s                output character to console, stall if congested
+   sim_con_flush_output         flush buffered console output
    sim_set_console              set console parameters
    sim_show_console             show console parameters
    sim_set_remote_console       set remote console parameters
@@ -114,6 +115,7 @@
    sim_ttisatty                 called to determine if running interactively
    sim_os_poll_kbd              poll for keyboard input
    sim_os_putchar               output character to console
+   sim_os_putbuf                output a buffer of characters to console
    sim_set_noconsole_port       Enable automatic WRU console polling
    sim_set_stable_registers_state Declare that all registers are always stable
 
@@ -147,6 +149,7 @@
 static t_stat sim_os_poll_kbd (void);
 static t_bool sim_os_poll_kbd_ready (int ms_timeout);
 static t_stat sim_os_putchar (int32 out);
+static t_stat sim_os_putbuf (const char *buf, size_t len);
 static t_stat sim_os_ttinit (void);
 static t_stat sim_os_ttrun (void);
 static t_stat sim_os_ttcmd (void);
@@ -2261,7 +2264,7 @@ sim_deb_switches = switches &
                     SWMASK ('T') | SWMASK ('A') | 
                     SWMASK ('F') | SWMASK ('N') |
                     SWMASK ('B') | SWMASK ('E') |
-                    SWMASK ('D') );                 /* save debug switches */
+                    SWMASK ('D') | SWMASK ('X') );  /* save debug switches */
 return old_deb_switches;
 }
 
@@ -2276,7 +2279,9 @@ size_t buffer_size;
 
 if ((cptr == NULL) || (*cptr == 0))                     /* need arg */
     return SCPE_2FARG;
-if (sim_switches & SWMASK ('B')) {
+if ((sim_switches & SWMASK ('B')) && (sim_switches & SWMASK ('X')))
+    return sim_messagef (SCPE_ARG, "The -B and -X switches are mutually exclusive\n");
+if (sim_switches & (SWMASK ('B') | SWMASK ('X'))) {
     cptr = get_glyph_nc (cptr, gbuf, 0);                /* buffer size */
     buffer_size = (size_t)strtoul (gbuf, NULL, 10);
     if ((buffer_size == 0) || (buffer_size > 1024))
@@ -2319,6 +2324,9 @@ if (sim_deb_switches & SWMASK ('E'))
 if (sim_deb_switches & SWMASK ('B'))
     sim_messagef (SCPE_OK, "   Debug messages will be written to a %u MB circular memory buffer\n", 
                                 (unsigned int)buffer_size);
+if (sim_deb_switches & SWMASK ('X'))
+    sim_messagef (SCPE_OK, "   Debug messages will be recorded in a %u MB circular binary trace buffer\n", 
+                                (unsigned int)buffer_size);
 time(&now);
 if (!sim_quiet) {
     fprintf (sim_deb, "Debug output to \"%s\" at %s", sim_logfile_name (sim_deb, sim_deb_ref), ctime(&now));
@@ -2333,6 +2341,12 @@ if (sim_deb_switches & SWMASK ('B')) {
     sim_debug_buffer_offset = sim_debug_buffer_inuse = 0;
     memset (sim_deb_buffer, 0, sim_deb_buffer_size);
     }
+if (sim_deb_switches & SWMASK ('X')) {
+    if (sim_deb_trace_open ((size_t)(1024 * 1024 * buffer_size)) != SCPE_OK) {
+        sim_set_deboff (0, NULL);
+        return sim_messagef (SCPE_MEM, "Can't allocate a %u MB debug trace buffer\n", (unsigned int)buffer_size);
+        }
+    }
 
 return SCPE_OK;
 }
@@ -2345,6 +2359,8 @@ if (cptr && (*cptr != 0))                               /* now eol? */
     return SCPE_2MARG;
 if (sim_deb == NULL)                                    /* no debug? */
     return SCPE_OK;
+if (sim_deb_switches & SWMASK ('X'))
+    sim_deb_trace_close ();
 if (sim_deb_switches & SWMASK ('B')) {
     size_t offset = (sim_debug_buffer_inuse == sim_deb_buffer_size) ? sim_debug_buffer_offset : 0;
     const char *bufmsg = "Circular Buffer Contents follow here:\n\n";
@@ -2391,6 +2407,8 @@ if (sim_deb) {
         fprintf (st, "   Debug messages are not being filtered to summarize duplicate lines\n");
     if (sim_deb_switches & SWMASK ('E'))
         fprintf (st, "   Debug messages containing blob data in EBCDIC will display in readable form\n");
+    if (sim_deb_switches & SWMASK ('X'))
+        fprintf (st, "   Debug messages are being recorded in a binary trace buffer\n");
     for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
         t_bool unit_debug = FALSE;
         uint32 unit;
@@ -2843,6 +2861,7 @@ t_stat sim_poll_kbd (void)
 t_stat c;
 
 sim_last_poll_kbd_time = sim_os_msec ();                    /* record when this poll happened */
+sim_con_flush_output ();                                    /* push out pending output */
 if (sim_send_poll_data (&sim_con_send, &c))                 /* injected input characters available? */
     return c;
 if (!sim_rem_master_mode) {
@@ -2881,18 +2900,80 @@ if ((c = (t_stat)tmxr_getc_ln (&sim_con_ldsc)))             /* any char? */
 return SCPE_OK;
 }
 
-/* Output character */
+/* Output character
 
-t_stat sim_putchar (int32 c)
+   While the simulator is running, in-window console output is collected
+   in sim_con_obuf and written to the host (and the console log) a block
+   at a time, rather than with a host call per character.  Telnet console
+   output is likewise left in the line's transmit buffer until a batch
+   has accumulated.  Pending output is flushed when the buffer fills,
+   whenever the keyboard is polled (which every simulator does at least
+   once per clock tick to notice the WRU character), before sim_printf
+   output and when returning to command mode.  Expect rules are still
+   checked as each character is produced, so match timing is unchanged.
+*/
+
+#define CON_OBUF_SIZE   4096                            /* in-window output buffer */
+#define CON_TXBATCH     64                              /* Telnet chars per xmt poll */
+
+static char sim_con_obuf[CON_OBUF_SIZE];
+static size_t sim_con_obuf_cnt = 0;
+
+#if defined(SIM_ASYNCH_IO) && defined(SIM_ASYNCH_MUX)
+extern t_bool sim_console_poll_running;
+#endif
+
+static t_bool sim_con_batch_output (void)
 {
-sim_exp_check (&sim_con_expect, c);
-if ((sim_con_tmxr.master == 0) &&                       /* not Telnet? */
-    (sim_con_ldsc.serport == 0)) {                      /* and not serial port */
+#if defined(SIM_ASYNCH_IO) && defined(SIM_ASYNCH_MUX)
+if (sim_console_poll_running)                           /* keyboard polled asynchronously? */
+    return FALSE;
+#endif
+return sim_is_running;
+}
+
+void sim_con_flush_output (void)
+{
+if (sim_con_obuf_cnt) {
+    if (sim_log)                                        /* log file? */
+        fwrite (sim_con_obuf, 1, sim_con_obuf_cnt, sim_log);
+    sim_os_putbuf (sim_con_obuf, sim_con_obuf_cnt);     /* in-window version */
+    sim_con_obuf_cnt = 0;
+    }
+if (sim_con_tmxr.master && tmxr_tqln (&sim_con_ldsc))   /* Telnet output pending? */
+    tmxr_poll_tx (&sim_con_tmxr);                       /* poll xmt */
+}
+
+static t_stat sim_con_putchar_local (int32 c)
+{
+sim_debug (DBG_XMT, &sim_con_telnet, "sim_putchar('%c' (0x%02X)\n", sim_isprint (c) ? c : '.', c);
+if (!sim_con_batch_output ()) {                         /* not running? */
+    sim_con_flush_output ();
     if (sim_log)                                        /* log file? */
         fputc (c, sim_log);
-    sim_debug (DBG_XMT, &sim_con_telnet, "sim_putchar('%c' (0x%02X)\n", sim_isprint (c) ? c : '.', c);
     return sim_os_putchar (c);                          /* in-window version */
     }
+sim_con_obuf[sim_con_obuf_cnt++] = (char)c;
+if (sim_con_obuf_cnt == sizeof (sim_con_obuf))          /* full? */
+    sim_con_flush_output ();
+return SCPE_OK;
+}
+
+static void sim_con_poll_tx (void)
+{
+if ((!sim_con_batch_output ()) ||                       /* not running */
+    (sim_con_ldsc.serport) ||                           /* or serial port */
+    (sim_con_ldsc.txbps) ||                             /* or rate limiting */
+    (tmxr_tqln (&sim_con_ldsc) >= CON_TXBATCH))         /* or batch accumulated? */
+    tmxr_poll_tx (&sim_con_tmxr);                       /* poll xmt */
+}
+
+t_stat sim_putchar (int32 c)
+{
+sim_exp_check (&sim_con_expect, c);
+if ((sim_con_tmxr.master == 0) &&                       /* not Telnet? */
+    (sim_con_ldsc.serport == 0))                        /* and not serial port */
+    return sim_con_putchar_local (c);
 if (!sim_con_ldsc.conn) {                               /* no Telnet or serial connection? */
     if (!sim_con_ldsc.txbfd)                            /* unbuffered? */
         return SCPE_LOST;                               /* connection lost */
@@ -2900,7 +2981,7 @@ if (!sim_con_ldsc.conn) {                               /* no Telnet or serial c
         sim_con_ldsc.rcve = 1;                          /* rcv enabled */
     }
 tmxr_putc_ln (&sim_con_ldsc, c);                        /* output char */
-tmxr_poll_tx (&sim_con_tmxr);                           /* poll xmt */
+sim_con_poll_tx ();                                     /* poll xmt */
 return SCPE_OK;
 }
 
@@ -2910,12 +2991,8 @@ t_stat r;
 
 sim_exp_check (&sim_con_expect, c);
 if ((sim_con_tmxr.master == 0) &&                       /* not Telnet? */
-    (sim_con_ldsc.serport == 0)) {                      /* and not serial port */
-    if (sim_log)                                        /* log file? */
-        fputc (c, sim_log);
-    sim_debug (DBG_XMT, &sim_con_telnet, "sim_putchar('%c' (0x%02X)\n", sim_isprint (c) ? c : '.', c);
-    return sim_os_putchar (c);                          /* in-window version */
-    }
+    (sim_con_ldsc.serport == 0))                        /* and not serial port */
+    return sim_con_putchar_local (c);
 if (!sim_con_ldsc.conn) {                               /* no Telnet or serial connection? */
     if (!sim_con_ldsc.txbfd)                            /* non-buffered Telnet connection? */
         return SCPE_LOST;                               /* lost */
@@ -2923,7 +3000,10 @@ if (!sim_con_ldsc.conn) {                               /* no Telnet or serial c
         sim_con_ldsc.rcve = 1;                          /* rcv enabled */
     }
 r = tmxr_putc_ln (&sim_con_ldsc, c);                    /* Telnet output */
-tmxr_poll_tx (&sim_con_tmxr);                           /* poll xmt */
+if (r != SCPE_OK)                                       /* stalled? */
+    tmxr_poll_tx (&sim_con_tmxr);                       /* drain what we can */
+else
+    sim_con_poll_tx ();                                 /* poll xmt */
 return r;                                               /* return status */
 }
 
@@ -3172,14 +3252,18 @@ if (sim_console_poll_running) {
 else
     pthread_mutex_unlock (&sim_tmxr_poll_lock);
 #endif
+sim_con_flush_output ();                                /* push out pending output */
 tmxr_stop_poll ();
 return sim_os_ttcmd ();
 }
 
 t_stat sim_ttclose (void)
 {
-t_stat r1 = tmxr_shutdown ();
-t_stat r2 = sim_os_ttclose ();
+t_stat r1, r2;
+
+sim_con_flush_output ();                                /* push out pending output */
+r1 = tmxr_shutdown ();
+r2 = sim_os_ttclose ();
 
 if (r1 != SCPE_OK)
     return r1;
@@ -3372,6 +3456,18 @@ if ((status != SS$_NORMAL) || (iosb.status != SS$_NORMAL))
 return SCPE_OK;
 }
 
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+unsigned int status;
+IOSB iosb;
+
+status = sys$qiow (EFN, tty_chan, IO$_WRITELBLK | IO$M_NOFORMAT,
+    &iosb, 0, 0, buf, len, 0, 0, 0, 0);
+if ((status != SS$_NORMAL) || (iosb.status != SS$_NORMAL))
+    return SCPE_TTOERR;
+return SCPE_OK;
+}
+
 /* Win32 routines */
 
 #elif defined (_WIN32)
@@ -3621,6 +3717,32 @@ if (c != 0177) {
 return SCPE_OK;
 }
 
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+DWORD unused;
+size_t run;
+
+while (len > 0) {
+    for (run = 0; (out_ptr == 0) && (run < len); run++) {  /* span of plain characters? */
+        uint8 c = (uint8)buf[run];
+
+        if ((c == 0177) || (c == BELL_CHAR) || (c == NUL_CHAR) ||
+            (c == CSI_CHAR) || (c == ESC_CHAR))
+            break;
+        }
+    if (run) {
+        WriteConsoleA(std_output, buf, (DWORD)run, &unused, NULL);
+        buf += run;
+        len -= run;
+        }
+    else {
+        sim_os_putchar ((uint8)*buf++);                 /* special or held characters */
+        --len;
+        }
+    }
+return SCPE_OK;
+}
+
 /* OS/2 routines, from Bruce Ray and Holger Veit */
 
 #elif defined (__OS2__)
@@ -3704,6 +3826,13 @@ if (c != 0177) {
 return SCPE_OK;
 }
 
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+while (len--)
+    sim_os_putchar (*buf++);
+return SCPE_OK;
+}
+
 /* Metrowerks CodeWarrior Macintosh routines, from Louis Chretien and
    Peter Schorn */
 
@@ -3897,6 +4026,15 @@ if (c != 0177) {
 return SCPE_OK;
 }
 
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+while (len--)
+    if (*buf++ != 0177)
+        putchar (buf[-1]);
+fflush (stdout);
+return SCPE_OK;
+}
+
 /* BSD UNIX routines */
 
 #elif defined (BSDTTY)
@@ -4049,6 +4187,20 @@ write (1, &c, 1);
 return SCPE_OK;
 }
 
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+ssize_t n;
+
+while (len > 0) {
+    n = write (1, buf, len);
+    if (n <= 0)
+        break;
+    buf += n;
+    len -= n;
+    }
+return SCPE_OK;
+}
+
 /* POSIX UNIX routines, from Leendert Van Doorn */
 
 #else
@@ -4223,6 +4375,20 @@ if (write (1, &c, 1)) {};
 return SCPE_OK;
 }
 
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+ssize_t n;
+
+while (len > 0) {
+    n = write (1, buf, len);
+    if (n <= 0)
+        break;
+    buf += n;
+    len -= n;
+    }
+return SCPE_OK;
+}
+
 #endif
 
 /* Decode a string.
@@ -988,6 +988,9 @@ const char *eth_capabilities(void)
 #endif
 #if defined (HAVE_SLIRP_NETWORK)
      ":NAT"
+#endif
+#if defined (HAVE_SHM_NETWORK)
+     ":SHM"
 #endif
      ":UDP";
  }
@@ -1043,6 +1046,18 @@ extern "C" {
 #include "sim_slirp.h"
 #endif /* HAVE_SLIRP_NETWORK */
 
+#ifdef HAVE_SHM_NETWORK
+#include "sim_fio.h"
+#include <errno.h>
+#if !defined(_WIN32)
+#include <signal.h>
+#endif
+#if defined(__linux) || defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#endif /* HAVE_SHM_NETWORK */
+
 /* Allows windows to look up user-defined adapter names */
 #if defined(_WIN32)
 #include <winreg.h>
@@ -1713,6 +1728,281 @@ _eth_callback((u_char *)opaque, &header, buf);
 }
 #endif
 
+#if defined(HAVE_SHM_NETWORK)
+/* Shared memory switch
+
+   A shm:name device is a port on a virtual switch which lives in a shared
+   memory segment.  Each port owns a receive ring which any other port may
+   fill, so a frame is moved with one copy and no system calls.  The ring
+   is a bounded multi-producer queue: a slot is free for sequence number
+   pos when its seq (biased by the slot index so a zero filled segment is
+   an empty switch) equals pos, and holds a frame when it equals pos+1.
+
+   Each port remembers the source addresses it has transmitted from.
+   Unicast frames are delivered to the port which has sent from the
+   destination address and are flooded to all ports otherwise.  The
+   receiving port still applies its own address filter.
+
+   On Linux an idle reader sleeps on a futex in the segment and is woken
+   by the sender, elsewhere an idle reader polls.
+
+   A sender which dies between claiming a slot and publishing it leaves
+   that slot (and everything queued behind it) unreadable, so a port taken
+   over from a prior owner starts with its whole ring reset rather than
+   draining it.
+*/
+
+#define ETH_SHM_PORTS   16                              /* ports per switch */
+#define ETH_SHM_RING    64                              /* frames per port (power of 2) */
+#define ETH_SHM_MACS    8                               /* learned addresses per port */
+#define ETH_SHM_NAMELEN 31                              /* longest segment name (macOS PSHMNAMLEN) */
+
+typedef struct {
+    int32       seq;                                    /* slot sequence (biased by index) */
+    int32       len;                                    /* frame length */
+    uint8       msg[ETH_FRAME_SIZE];                    /* frame */
+    } ETH_SHM_SLOT;
+
+typedef struct {
+    int32       pid;                                    /* owning process (0 if free) */
+    int32       tail;                                   /* next slot to fill */
+    int32       head;                                   /* next slot to drain */
+    int32       waiting;                                /* owner waiting for frames */
+    int32       wakeups;                                /* owner wakeup counter */
+    int32       drops;                                  /* frames dropped (ring full) */
+    int32       mac_next;                               /* next learned address to replace */
+    ETH_MAC     macs[ETH_SHM_MACS];                     /* learned source addresses */
+    ETH_SHM_SLOT ring[ETH_SHM_RING];
+    } ETH_SHM_PORT;
+
+typedef struct {
+    ETH_SHM_PORT port[ETH_SHM_PORTS];
+    } ETH_SHM_SWITCH;
+
+typedef struct {
+    SHMEM       *shmem;
+    ETH_SHM_SWITCH *sw;
+    int         port;
+    } ETH_SHM;
+
+#define ETH_SHM_LOAD(v) sim_shmem_atomic_add (&(v), 0)
+
+static int32 _eth_shm_pid (void)
+{
+#if defined(_WIN32)
+return (int32)GetCurrentProcessId ();
+#else
+return (int32)getpid ();
+#endif
+}
+
+static t_bool _eth_shm_pid_alive (int32 pid)
+{
+#if defined(_WIN32)
+HANDLE hProcess = OpenProcess (SYNCHRONIZE, FALSE, (DWORD)pid);
+t_bool alive;
+
+if (hProcess == NULL)
+  return FALSE;
+alive = (WaitForSingleObject (hProcess, 0) == WAIT_TIMEOUT);
+CloseHandle (hProcess);
+return alive;
+#else
+return ((kill ((pid_t)pid, 0) == 0) || (errno != ESRCH));
+#endif
+}
+
+static t_stat _eth_shm_open (const char *switchname, ETH_SHM **shm, char errbuf[PCAP_ERRBUF_SIZE])
+{
+char segname[CBUFSIZE];
+int32 pid = _eth_shm_pid ();
+int port;
+void *addr;
+t_stat r;
+
+*shm = NULL;
+snprintf (segname, sizeof (segname), "simh-eth-%s", switchname);
+if (1 + strlen (segname) > ETH_SHM_NAMELEN) {       /* shm_open adds a leading / */
+  snprintf (errbuf, PCAP_ERRBUF_SIZE, "Shared memory switch name %s is longer than %d characters", switchname, (int)(ETH_SHM_NAMELEN - 1 - strlen ("simh-eth-")));
+  return SCPE_OPENERR;
+  }
+*shm = (ETH_SHM *)calloc (1, sizeof (**shm));
+if (*shm == NULL)
+  return SCPE_MEM;
+r = sim_shmem_open (segname, sizeof (ETH_SHM_SWITCH), &(*shm)->shmem, &addr);
+if (r != SCPE_OK) {
+  free (*shm);
+  *shm = NULL;
+  snprintf (errbuf, PCAP_ERRBUF_SIZE, "Can't open shared memory switch %s", switchname);
+  return r;
+  }
+(*shm)->sw = (ETH_SHM_SWITCH *)addr;
+for (port = 0; port < ETH_SHM_PORTS; port++) {
+  ETH_SHM_PORT *p = &(*shm)->sw->port[port];
+  int32 owner = ETH_SHM_LOAD (p->pid);
+
+  if (((owner == 0) || (!_eth_shm_pid_alive (owner))) &&
+      sim_shmem_atomic_cas (&p->pid, owner, pid))
+    break;
+  }
+if (port == ETH_SHM_PORTS) {
+  sim_shmem_close ((*shm)->shmem);
+  free (*shm);
+  *shm = NULL;
+  snprintf (errbuf, PCAP_ERRBUF_SIZE, "All %d ports on shared memory switch %s are in use", ETH_SHM_PORTS, switchname);
+  return SCPE_OPENERR;
+  }
+(*shm)->port = port;
+if (1) {                                            /* reset the ring left by a prior owner */
+  ETH_SHM_PORT *p = &(*shm)->sw->port[port];
+  uint32 tail = (uint32)ETH_SHM_LOAD (p->tail);
+  uint32 idx;
+
+  memset (p->macs, 0, sizeof (p->macs));
+  p->drops = 0;
+  for (idx = 0; idx < ETH_SHM_RING; idx++) {    /* each slot free for its next pos >= tail */
+    ETH_SHM_SLOT *slot = &p->ring[idx];
+    uint32 pos = tail + ((idx - tail) & (ETH_SHM_RING - 1));
+
+    sim_shmem_atomic_add (&slot->seq, (int32)((pos - idx) - (uint32)ETH_SHM_LOAD (slot->seq)));
+    }
+  p->head = (int32)tail;
+  }
+return SCPE_OK;
+}
+
+static void _eth_shm_close (ETH_SHM *shm)
+{
+ETH_SHM_PORT *p = &shm->sw->port[shm->port];
+
+memset (p->macs, 0, sizeof (p->macs));
+sim_shmem_atomic_cas (&p->pid, _eth_shm_pid (), 0);
+sim_shmem_close (shm->shmem);
+free (shm);
+}
+
+static void _eth_shm_wake (ETH_SHM_PORT *p)
+{
+if (ETH_SHM_LOAD (p->waiting)) {
+  sim_shmem_atomic_add (&p->wakeups, 1);
+#if defined(__linux) || defined(__linux__)
+  syscall (SYS_futex, &p->wakeups, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+  }
+}
+
+static t_bool _eth_shm_put (ETH_SHM_PORT *p, const uint8 *msg, int len)
+{
+uint32 pos = (uint32)ETH_SHM_LOAD (p->tail);
+
+while (1) {
+  ETH_SHM_SLOT *slot = &p->ring[pos & (ETH_SHM_RING - 1)];
+  int32 dif = (int32)(((uint32)ETH_SHM_LOAD (slot->seq) + (pos & (ETH_SHM_RING - 1))) - pos);
+
+  if (dif == 0) {
+    if (sim_shmem_atomic_cas (&p->tail, (int32)pos, (int32)(pos + 1))) {
+      slot->len = len;
+      memcpy (slot->msg, msg, len);
+      sim_shmem_atomic_add (&slot->seq, 1);     /* publish */
+      _eth_shm_wake (p);
+      return TRUE;
+      }
+    }
+  else
+    if (dif < 0) {                              /* ring full */
+      sim_shmem_atomic_add (&p->drops, 1);
+      return FALSE;
+      }
+  pos = (uint32)ETH_SHM_LOAD (p->tail);
+  }
+}
+
+static int _eth_shm_send (ETH_DEV *dev, const uint8 *msg, int len)
+{
+ETH_SHM *shm = (ETH_SHM *)dev->handle;
+ETH_SHM_PORT *self = &shm->sw->port[shm->port];
+int i, port, dest = -1;
+
+if (len > ETH_FRAME_SIZE)
+  return -1;
+for (i = 0; i < ETH_SHM_MACS; i++)              /* learn source address */
+  if (memcmp (self->macs[i], &msg[6], sizeof (ETH_MAC)) == 0)
+    break;
+if (i == ETH_SHM_MACS) {
+  memcpy (self->macs[self->mac_next], &msg[6], sizeof (ETH_MAC));
+  self->mac_next = (self->mac_next + 1) % ETH_SHM_MACS;
+  }
+if (!(msg[0] & 0x01)) {                         /* unicast? */
+  for (port = 0; (port < ETH_SHM_PORTS) && (dest < 0); port++) {
+    if ((port == shm->port) || (shm->sw->port[port].pid == 0))
+      continue;
+    for (i = 0; i < ETH_SHM_MACS; i++)
+      if (memcmp (shm->sw->port[port].macs[i], msg, sizeof (ETH_MAC)) == 0) {
+        dest = port;
+        break;
+        }
+    }
+  }
+if (dest >= 0)
+  _eth_shm_put (&shm->sw->port[dest], msg, len);
+else {
+  for (port = 0; port < ETH_SHM_PORTS; port++)
+    if ((port != shm->port) && (shm->sw->port[port].pid != 0))
+      _eth_shm_put (&shm->sw->port[port], msg, len);
+  }
+return 0;
+}
+
+/* Deliver up to max frames from this port's ring, returns the number delivered */
+
+static int _eth_shm_dispatch (ETH_DEV *dev, int max)
+{
+ETH_SHM *shm = (ETH_SHM *)dev->handle;
+ETH_SHM_PORT *p = &shm->sw->port[shm->port];
+int count = 0;
+
+while (count < max) {
+  uint32 pos = (uint32)p->head;
+  ETH_SHM_SLOT *slot = &p->ring[pos & (ETH_SHM_RING - 1)];
+  struct pcap_pkthdr header;
+
+  if ((uint32)ETH_SHM_LOAD (slot->seq) + (pos & (ETH_SHM_RING - 1)) != pos + 1)
+    break;                                      /* empty */
+  memset (&header, 0, sizeof(header));
+  header.caplen = header.len = slot->len;
+  _eth_callback ((u_char *)dev, &header, slot->msg);
+  sim_shmem_atomic_add (&slot->seq, ETH_SHM_RING - 1);/* release slot */
+  p->head = (int32)(pos + 1);
+  ++count;
+  }
+return count;
+}
+
+#if defined (USE_READER_THREAD)
+static void _eth_shm_wait (ETH_DEV *dev, int msec)
+{
+ETH_SHM *shm = (ETH_SHM *)dev->handle;
+ETH_SHM_PORT *p = &shm->sw->port[shm->port];
+ETH_SHM_SLOT *slot = &p->ring[(uint32)p->head & (ETH_SHM_RING - 1)];
+int32 wakeups = ETH_SHM_LOAD (p->wakeups);
+
+sim_shmem_atomic_cas (&p->waiting, 0, 1);
+if ((uint32)ETH_SHM_LOAD (slot->seq) + ((uint32)p->head & (ETH_SHM_RING - 1)) != (uint32)p->head + 1) {
+#if defined(__linux) || defined(__linux__)
+  struct timespec timeout;
+
+  timeout.tv_sec = msec / 1000;
+  timeout.tv_nsec = (msec % 1000) * 1000000;
+  syscall (SYS_futex, &p->wakeups, FUTEX_WAIT, wakeups, &timeout, NULL, 0);
+#else
+  sim_os_ms_sleep (1);
+#endif
+  }
+sim_shmem_atomic_cas (&p->waiting, 1, 0);
+}
+#endif /* USE_READER_THREAD */
+#endif /* HAVE_SHM_NETWORK */
+
 #if defined (USE_READER_THREAD)
 static void *
 _eth_reader(void *arg)
@@ -1757,7 +2047,7 @@ while (dev->handle) {
     if (WAIT_OBJECT_0 == WaitForSingleObject (hWait, 250))
       sel_ret = 1;
     }
-  if ((dev->eth_api == ETH_API_UDP) || (dev->eth_api == ETH_API_NAT))
+  if ((dev->eth_api == ETH_API_UDP) || (dev->eth_api == ETH_API_NAT) || (dev->eth_api == ETH_API_SHM))
 #endif /* _WIN32 */
   if (1) {
     if (do_select) {
@@ -1845,6 +2135,13 @@ while (dev->handle) {
         status = 1;
         break;
 #endif /* HAVE_SLIRP_NETWORK */
+#ifdef HAVE_SHM_NETWORK
+      case ETH_API_SHM:
+        status = _eth_shm_dispatch (dev, ETH_SHM_RING);
+        if (status == 0)
+          _eth_shm_wait (dev, 250);
+        break;
+#endif /* HAVE_SHM_NETWORK */
       case ETH_API_UDP:
         if (1) {
           struct pcap_pkthdr header;
@@ -2014,6 +2311,24 @@ if (bufsz < ETH_MAX_JUMBO_FRAME)
 
 /* attempt to connect device */
 memset(errbuf, 0, PCAP_ERRBUF_SIZE);
+if (0 == strncmp("shm:", savname, 4)) {
+#if defined(HAVE_SHM_NETWORK)
+  const char *devname = savname + 4;
+  t_stat r;
+
+  while (isspace(*devname))
+    ++devname;
+  if ((*devname == '\0') || (!strcmp(devname, "switchname")))
+    return sim_messagef (SCPE_OPENERR, "Eth: Must specify actual shm switch name (i.e. shm:cluster)\n");
+  r = _eth_shm_open (devname, (ETH_SHM **)handle, errbuf);
+  if (r != SCPE_OK)
+    return r;
+  *eth_api = ETH_API_SHM;
+  return SCPE_OK;
+#else
+  return sim_messagef (SCPE_OPENERR, "Eth: No support for shm: network devices\n");
+#endif /* defined(HAVE_SHM_NETWORK) */
+  }
 if (0 == strncmp("tap:", savname, 4)) {
   int  tun = -1;    /* TUN/TAP Socket */
   int  on = 1;
@@ -2419,6 +2734,11 @@ switch (eth_api) {
   case ETH_API_UDP:
     sim_close_sock(pcap_fd);
     break;
+#ifdef HAVE_SHM_NETWORK
+  case ETH_API_SHM:
+    _eth_shm_close((ETH_SHM*)pcap);
+    break;
+#endif
   }
 return SCPE_OK;
 }
@@ -2497,6 +2817,9 @@ fprintf (st, "    eth2   vde:device{:switch-port-number}      (Integrated VDE su
 fprintf (st, "    eth3   nat:{optional-nat-parameters}        (Integrated NAT (SLiRP) support)\n");
 #endif
 fprintf (st, "    eth4   udp:sourceport:remotehost:remoteport (Integrated UDP bridge support)\n");
+#if defined(HAVE_SHM_NETWORK)
+fprintf (st, "    eth5   shm:switchname                       (Integrated shared memory switch support)\n");
+#endif
 fprintf (st, "   sim> ATTACH %s eth0\n\n", dptr->name);
 fprintf (st, "or equivalently:\n\n");
 fprintf (st, "   sim> ATTACH %s en0\n\n", dptr->name);
@@ -2714,6 +3037,9 @@ switch (dev->eth_api) {
   case ETH_API_NAT:
       netname = "nat";
       break;
+  case ETH_API_SHM:
+      netname = "shm";
+      break;
   }
 sprintf(msg, "%s(%s): ", where, netname);
 switch (dev->eth_api) {
@@ -2846,6 +3172,11 @@ if ((packet->len >= ETH_MIN_PACKET) && (packet->len <= ETH_MAX_PACKET)) {
     case ETH_API_UDP:
       status = (((int32)packet->len == sim_write_sock (dev->fd_handle, (char *)packet->msg, (int32)packet->len)) ? 0 : -1);
       break;
+#ifdef HAVE_SHM_NETWORK
+    case ETH_API_SHM:
+      status = _eth_shm_send (dev, packet->msg, (int)packet->len);
+      break;
+#endif
     }
   ++dev->packets_sent;              /* basic bookkeeping */
   /* On error, correct loopback bookkeeping */
@@ -2938,6 +3269,88 @@ key ^= 0x3f;
 return (hash[key>>3] & (1 << (key&0x7)));
 }
 
+/* Compiled address filter
+
+   The filter addresses are kept in a small open addressed hash set of
+   48-bit keys (bit 48 marks a used slot) which eth_filter_hash rebuilds,
+   so a received frame costs one probe for each of its addresses rather
+   than a compare against every filter address.
+*/
+
+static t_uint64
+_eth_filter_key(const u_char* mac)
+{
+return ((t_uint64)1 << 48) |
+       ((t_uint64)mac[0] << 40) | ((t_uint64)mac[1] << 32) | ((t_uint64)mac[2] << 24) |
+       ((t_uint64)mac[3] << 16) | ((t_uint64)mac[4] << 8) | (t_uint64)mac[5];
+}
+
+static uint32
+_eth_filter_slot(t_uint64 key)
+{
+uint32 h = (uint32)key ^ (uint32)(key >> 24);
+
+return ((h * 0x9E3779B1) >> 16) & (ETH_FILTER_TABLE - 1);
+}
+
+static void
+_eth_filter_compile(ETH_DEV* dev)
+{
+t_uint64 table[ETH_FILTER_TABLE];
+int i;
+
+/* Build the set aside, the reader thread may be probing the live one */
+memset(table, 0, sizeof(table));
+for (i = 0; i < dev->addr_count; i++) {
+  t_uint64 key = _eth_filter_key(dev->filter_address[i]);
+  uint32 slot = _eth_filter_slot(key);
+
+  while ((table[slot] != 0) && (table[slot] != key))
+    slot = (slot + 1) & (ETH_FILTER_TABLE - 1);
+  table[slot] = key;
+  }
+memcpy(dev->filter_table, table, sizeof(dev->filter_table));
+}
+
+static int
+_eth_filter_lookup(ETH_DEV* dev, const u_char* mac)
+{
+t_uint64 key = _eth_filter_key(mac);
+uint32 slot = _eth_filter_slot(key);
+
+while (dev->filter_table[slot] != 0) {
+  if (dev->filter_table[slot] == key)
+    return 1;
+  slot = (slot + 1) & (ETH_FILTER_TABLE - 1);
+  }
+return 0;
+}
+
+/* Apply the address filters to a received frame when BPF isn't doing it.
+   Returns whether the frame is addressed to us and sets from_me when it
+   was sent from one of our addresses. */
+
+static int
+_eth_filter_frame(ETH_DEV* dev, const u_char* data, int* from_me)
+{
+int to_me = _eth_filter_lookup(dev, data);
+
+*from_me = _eth_filter_lookup(dev, &data[6]);
+
+/* promiscuous mode? */
+if (dev->promiscuous) to_me = 1;
+
+/* all multicast mode or AUTODIN II hash mode? */
+if ((!to_me) && (data[0] & 0x01)) {
+  if (dev->all_multicast)
+    to_me = 1;
+  else
+    if (dev->hash_filter)
+      to_me = _eth_hash_lookup(dev->hash, data);
+  }
+return to_me;
+}
+
 #if 0
 static int
 _eth_hash_validate(ETH_MAC *MultiCastList, int count, ETH_MULTIHASH hash)
@@ -3433,7 +3846,7 @@ _eth_callback(u_char* info, const struct pcap_pkthdr* header, const u_char* data
 ETH_DEV*  dev = (ETH_DEV*) info;
 int to_me;
 int from_me = 0;
-int i;
+int ignored = 0;
 int bpf_used;
 
 if (LOOPBACK_PHYSICAL_RESPONSE(dev, data)) {
@@ -3463,24 +3876,11 @@ switch (dev->eth_api) {
   case ETH_API_VDE:
   case ETH_API_UDP:
   case ETH_API_NAT:
+  case ETH_API_SHM:
     bpf_used = 0;
-    to_me = 0;
     eth_packet_trace (dev, data, header->len, "received");
 
-    for (i = 0; i < dev->addr_count; i++) {
-      if (memcmp(data, dev->filter_address[i], 6) == 0) to_me = 1;
-      if (memcmp(&data[6], dev->filter_address[i], 6) == 0) from_me = 1;
-    }
-
-    /* all multicast mode? */
-    if (dev->all_multicast && (data[0] & 0x01)) to_me = 1;
-
-    /* promiscuous mode? */
-    if (dev->promiscuous) to_me = 1;
-
-    /* AUTODIN II hash mode? */
-    if ((dev->hash_filter) && (!to_me) && (data[0] & 0x01))
-      to_me = _eth_hash_lookup(dev->hash, data);
+    to_me = _eth_filter_frame(dev, data, &from_me);
     break;
   default:
     bpf_used = to_me = 0;                           /* Should NEVER happen */
@@ -3500,6 +3900,7 @@ if ((LOOPBACK_SELF_FRAME(dev->physical_addr, data)) ||
     eth_packet_trace (dev, data, header->len, "ignored");
     dev->loopback_self_sent--;
     to_me = 0;
+    ignored = 1;
     }
   else
     if (!bpf_used)
@@ -3584,6 +3985,15 @@ if (bpf_used ? to_me : (to_me && !from_me)) {
     (dev->read_callback)(0);
 #endif
   }
+else {                                              /* count filtered frames */
+  if (to_me || ignored)
+    ++dev->filter_drop_self;
+  else
+    if (data[0] & 0x01)
+      ++dev->filter_drop_multicast;
+    else
+      ++dev->filter_drop_unicast;
+  }
 }
 
 int eth_read(ETH_DEV* dev, ETH_PACK* packet, ETH_PCALLBACK routine)
@@ -3680,6 +4090,11 @@ do {
           }
         }
       break;
+#ifdef HAVE_SHM_NETWORK
+    case ETH_API_SHM:
+      status = _eth_shm_dispatch (dev, 1);
+      break;
+#endif
     }
   } while ((status > 0) && (0 == packet->len));
 if (status < 0) {
@@ -3838,6 +4253,7 @@ if (dev->reflections == -1)
 for (i = 0; i < addr_count; i++)
   memcpy(dev->filter_address[i], addresses[i], sizeof(ETH_MAC));
 dev->addr_count = addr_count;
+_eth_filter_compile(dev);
 
 /* store other flags */
 dev->all_multicast = all_multicast;
@@ -4073,6 +4489,14 @@ if (used < max) {
   list[used].eth_api = ETH_API_UDP;
   ++used;
   }
+#ifdef HAVE_SHM_NETWORK
+if (used < max) {
+  sprintf(list[used].name, "%s", "shm:switchname");
+  sprintf(list[used].desc, "%s", "Integrated shared memory switch support");
+  list[used].eth_api = ETH_API_SHM;
+  ++used;
+  }
+#endif
 
 return used;
 }
@@ -4143,6 +4567,12 @@ if (dev->jumbo_fragmented)
   fprintf(st, "  Jumbo Fragmented:        %d\n", dev->jumbo_fragmented);
 if (dev->jumbo_truncated)
   fprintf(st, "  Jumbo Truncated:         %d\n", dev->jumbo_truncated);
+if (dev->filter_drop_unicast)
+  fprintf(st, "  Filtered Unicast:        %d\n", dev->filter_drop_unicast);
+if (dev->filter_drop_multicast)
+  fprintf(st, "  Filtered Multicast:      %d\n", dev->filter_drop_multicast);
+if (dev->filter_drop_self)
+  fprintf(st, "  Filtered Self Sent:      %d\n", dev->filter_drop_self);
 if (dev->packets_sent)
   fprintf(st, "  Packets Sent:            %d\n", dev->packets_sent);
 if (dev->transmit_packet_errors)
@@ -4172,6 +4602,14 @@ if (dev->bpf_filter)
 if (dev->eth_api == ETH_API_NAT)
   sim_slirp_show ((SLIRP *)dev->handle, st);
 #endif
+#if defined(HAVE_SHM_NETWORK)
+if (dev->eth_api == ETH_API_SHM) {
+  ETH_SHM *shm = (ETH_SHM *)dev->handle;
+
+  fprintf(st, "  Switch Port:             %d\n", shm->port);
+  fprintf(st, "  Switch Port Drops:       %d\n", shm->sw->port[shm->port].drops);
+  }
+#endif
 }
 
 static
@@ -4290,7 +4728,8 @@ for (eth_num=0; eth_num<eth_device_count; eth_num++) {
   if ((0 == memcmp (eth_list[eth_num].name, "nat:", 4)) ||
       (0 == memcmp (eth_list[eth_num].name, "tap:", 4)) ||
       (0 == memcmp (eth_list[eth_num].name, "vde:", 4)) ||
-      (0 == memcmp (eth_list[eth_num].name, "udp:", 4)))
+      (0 == memcmp (eth_list[eth_num].name, "udp:", 4)) ||
+      (0 == memcmp (eth_list[eth_num].name, "shm:", 4)))
       continue;
   eth_name[sizeof (eth_name)-1] = '\0';
   snprintf (eth_name, sizeof (eth_name)-1, "eth%d", eth_num);
@@ -4369,6 +4808,106 @@ if (bpf_compile_skip_count)
 return (errors == 0) ? SCPE_OK : SCPE_IERR;
 }
 
+static int
+_eth_test_accept (ETH_DEV *dev, const u_char *dst, const u_char *src)
+{
+u_char frame[ETH_MIN_PACKET];
+int to_me, from_me;
+
+memset (frame, 0, sizeof (frame));
+memcpy (&frame[0], dst, sizeof (ETH_MAC));
+memcpy (&frame[6], src, sizeof (ETH_MAC));
+to_me = _eth_filter_frame (dev, frame, &from_me);
+return (to_me && !from_me);
+}
+
+static
+t_stat eth_test_filter (DEVICE *dptr)
+{
+int errors = 0;
+ETH_DEV dev;
+ETH_MAC addrs[4];
+ETH_MAC collide[3];
+ETH_MAC other_mc;
+ETH_MULTIHASH hash;
+int i, n, key;
+static ETH_MAC unicast   = {0x08, 0x00, 0x2B, 0x01, 0x02, 0x03};
+static ETH_MAC stranger  = {0x08, 0x00, 0x2B, 0x0A, 0x0B, 0x0C};
+static ETH_MAC broadcast = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static ETH_MAC multicast = {0x09, 0x00, 0x2B, 0x00, 0x00, 0x0F};
+#define ETH_TEST_FILTER(desc, dst, src, expect)                         \
+    if (_eth_test_accept (&dev, dst, src) != (expect)) {                \
+      sim_printf ("Eth: Filter %s: expected %s\n", desc,                \
+                  (expect) ? "accept" : "reject");                      \
+      ++errors;                                                         \
+      }
+
+memset (&dev, 0, sizeof (dev));
+dev.dptr = dptr;
+dev.reflections = 0;
+dev.eth_api = ETH_API_TAP;                  /* no BPF, filters applied here */
+
+/* unicast and broadcast hits and misses, and our own frames */
+memcpy (addrs[0], unicast, sizeof (ETH_MAC));
+memcpy (addrs[1], broadcast, sizeof (ETH_MAC));
+eth_filter_hash (&dev, 2, addrs, FALSE, FALSE, NULL);
+ETH_TEST_FILTER("unicast hit", unicast, stranger, 1);
+ETH_TEST_FILTER("unicast miss", stranger, unicast, 0);
+ETH_TEST_FILTER("broadcast hit", broadcast, stranger, 1);
+ETH_TEST_FILTER("multicast miss", multicast, stranger, 0);
+ETH_TEST_FILTER("self sent", broadcast, unicast, 0);
+
+/* addresses which probe the same slot */
+for (i = n = 0; (n < 3) && (i < 0x10000); i++) {
+  ETH_MAC mac = {0x08, 0x00, 0x2B, 0x00, 0x00, 0x00};
+
+  mac[4] = (u_char)(i >> 8);
+  mac[5] = (u_char)i;
+  if ((memcmp (mac, unicast, sizeof (ETH_MAC)) != 0) &&
+      (_eth_filter_slot (_eth_filter_key (mac)) == _eth_filter_slot (_eth_filter_key (unicast))))
+    memcpy (collide[n++], mac, sizeof (ETH_MAC));
+  }
+if (n < 3) {
+  sim_printf ("Eth: Filter: no colliding addresses found\n");
+  ++errors;
+  }
+else {
+  memcpy (addrs[1], collide[0], sizeof (ETH_MAC));
+  memcpy (addrs[2], collide[1], sizeof (ETH_MAC));
+  eth_filter_hash (&dev, 3, addrs, FALSE, FALSE, NULL);
+  ETH_TEST_FILTER("collision first", unicast, stranger, 1);
+  ETH_TEST_FILTER("collision second", collide[0], stranger, 1);
+  ETH_TEST_FILTER("collision third", collide[1], stranger, 1);
+  ETH_TEST_FILTER("collision miss", collide[2], stranger, 0);
+  }
+
+/* all multicast */
+eth_filter_hash (&dev, 1, addrs, TRUE, FALSE, NULL);
+ETH_TEST_FILTER("all multicast", multicast, stranger, 1);
+ETH_TEST_FILTER("all multicast unicast miss", stranger, unicast, 0);
+
+/* promiscuous */
+eth_filter_hash (&dev, 1, addrs, FALSE, TRUE, NULL);
+ETH_TEST_FILTER("promiscuous", stranger, broadcast, 1);
+ETH_TEST_FILTER("promiscuous self sent", stranger, unicast, 0);
+
+/* AUTODIN II multicast hash with just the bit for multicast set */
+key = 0x3f ^ (0x3f & (eth_crc32 (0, multicast, 6) >> 26));
+memset (hash, 0, sizeof (hash));
+hash[key >> 3] = (u_char)(1 << (key & 7));
+memcpy (other_mc, multicast, sizeof (ETH_MAC));
+do
+  ++other_mc[5];
+while (key == (0x3f ^ (0x3f & (eth_crc32 (0, other_mc, 6) >> 26))));
+eth_filter_hash (&dev, 1, addrs, FALSE, FALSE, &hash);
+ETH_TEST_FILTER("hash hit", multicast, stranger, 1);
+ETH_TEST_FILTER("hash miss", other_mc, stranger, 0);
+ETH_TEST_FILTER("hash unicast miss", stranger, broadcast, 0);
+ETH_TEST_FILTER("hash unicast hit", unicast, stranger, 1);
+#undef ETH_TEST_FILTER
+return (errors == 0) ? SCPE_OK : SCPE_IERR;
+}
+
 #include <setjmp.h>
 
 t_stat sim_ether_test (DEVICE *dptr)
@@ -4380,6 +4919,7 @@ sim_printf ("Testing %s device sim_ether APIs\n", dptr->name);
 
 SIM_TEST(eth_test_crc32 (dptr));
 SIM_TEST(eth_test_bpf (dptr));
+SIM_TEST(eth_test_filter (dptr));
 return stat;
 }
 #endif /* USE_NETWORK */
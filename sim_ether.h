@@ -129,6 +129,12 @@ extern "C" {
 #undef USE_SHARED
 #endif
 
+/* shm: devices need shared memory segments and atomic operations (the
+   GCC __sync builtins or the Windows Interlocked functions) */
+#if defined(_WIN32) || (defined(HAVE_SHM_OPEN) && defined(__GNUC__) && (defined(__linux__) || defined(__APPLE__)))
+#define HAVE_SHM_NETWORK 1
+#endif
+
 /* USE_SHARED implies shared pcap, so force HAVE_PCAP_NETWORK */
 #if defined(USE_SHARED) && !defined(HAVE_PCAP_NETWORK)
 #define HAVE_PCAP_NETWORK 1
@@ -158,6 +164,7 @@ extern "C" {
 #define ETH_PROMISC            1                        /* promiscuous mode = true */
 #define ETH_TIMEOUT           -1                        /* read timeout in milliseconds (immediate) */
 #define ETH_FILTER_MAX        20                        /* maximum address filters */
+#define ETH_FILTER_TABLE      64                        /* compiled address filter slots (power of 2) */
 #define ETH_DEV_NAME_MAX     256                        /* maximum device name size */
 #define ETH_DEV_DESC_MAX     256                        /* maximum device description size */
 #define ETH_MIN_PACKET        60                        /* minimum ethernet packet size */
@@ -264,6 +271,7 @@ struct eth_device {
 #define ETH_API_VDE  3                                  /* VDE API in use */
 #define ETH_API_UDP  4                                  /* UDP API in use */
 #define ETH_API_NAT  5                                  /* NAT (SLiRP) API in use */
+#define ETH_API_SHM  6                                  /* Shared memory switch API in use */
   ETH_PCALLBACK read_callback;                          /* read callback function */
   ETH_PCALLBACK write_callback;                         /* write callback function */
   ETH_PACK*     read_packet;                            /* read packet */
@@ -273,6 +281,7 @@ struct eth_device {
   ETH_BOOL      all_multicast;                          /* receive all multicast messages */
   ETH_BOOL      hash_filter;                            /* filter using AUTODIN II multicast hash */
   ETH_MULTIHASH hash;                                   /* AUTODIN II multicast hash */
+  t_uint64      filter_table[ETH_FILTER_TABLE];         /* filter addresses compiled into a hash set */
   int32         loopback_self_sent;                     /* loopback packets sent but not seen */
   int32         loopback_self_sent_total;               /* total loopback packets sent */
   int32         loopback_self_rcvd_total;               /* total loopback packets seen */
@@ -282,6 +291,9 @@ struct eth_device {
   uint32        jumbo_fragmented;                       /* Giant IPv4 Frames Fragmented */
   uint32        jumbo_dropped;                          /* Giant Frames Dropped */
   uint32        jumbo_truncated;                        /* Giant Frames too big for capture buffer - Dropped */
+  uint32        filter_drop_unicast;                    /* Unicast Frames Filtered */
+  uint32        filter_drop_multicast;                  /* Multicast Frames Filtered */
+  uint32        filter_drop_self;                       /* Frames We Sent Filtered */
   uint32        packets_sent;                           /* Total Packets Sent */
   uint32        packets_received;                       /* Total Packets Received */
   uint32        loopback_packets_processed;             /* Total Loopback Packets Processed */
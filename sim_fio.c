@@ -50,8 +50,13 @@
    sim_fsize_name_ex -       get file size as a t_offset of named file
    sim_buf_copy_swapped -    copy data swapping elements along the way
    sim_buf_swap_data -       swap data elements inplace in buffer
+   sim_fio_test      -       verify (and optionally time) the element swap routines
    sim_shmem_open            create or attach to a shared memory region
    sim_shmem_close           close a shared memory region
+   sim_mem_alloc             allocate zeroed simulated memory
+   sim_mem_resize            resize simulated memory, preserving contents
+   sim_mem_free              release simulated memory
+   sim_mem_resident          bytes of simulated memory backed by the host
 
 
    sim_fopen and sim_fseek are OS-dependent.  The other routines are not.
@@ -93,8 +98,99 @@ t_bool sim_toffset_64;              /* Large File (>2GB) file I/O Support availa
    are size char, then the calls are passed directly to fread or
    fwrite.  Otherwise, these routines perform the necessary byte swaps.
    Sim_fread swaps in place, sim_fwrite uses an intermediate buffer.
+
+   The common 2, 4 and 8 byte element sizes are swapped a whole element
+   at a time with the compiler's byte reverse builtins, which become
+   single byte reversing loads/stores (or vector shuffles) on most hosts.
+   Other element sizes are reversed a byte at a time.  Since each element
+   is loaded before it is stored, the same loops serve in place swaps.
 */
 
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8))))
+#define SWAP16(v)   __builtin_bswap16 (v)
+#define SWAP32(v)   __builtin_bswap32 (v)
+#define SWAP64(v)   __builtin_bswap64 (v)
+#elif defined(_MSC_VER)
+#define SWAP16(v)   _byteswap_ushort (v)
+#define SWAP32(v)   _byteswap_ulong (v)
+#define SWAP64(v)   _byteswap_uint64 (v)
+#else
+#define SWAP16(v)   ((uint16)(((v) >> 8) | ((v) << 8)))
+#define SWAP32(v)   ((((v) >> 24) & 0xFF) | (((v) >> 8) & 0xFF00) | \
+                     (((v) & 0xFF00) << 8) | (((v) & 0xFF) << 24))
+#define SWAP64(v)   (((t_uint64)SWAP32 ((uint32)(v)) << 32) | SWAP32 ((uint32)((v) >> 32)))
+#endif
+
+/* Copy count elements of size bytes from sbuf to dbuf reversing each
+   element's bytes.  sbuf and dbuf may be the same buffer. */
+
+static void _sim_buf_swap (void *dbuf, const void *sbuf, size_t size, size_t count)
+{
+const unsigned char *sptr = (const unsigned char *)sbuf;
+unsigned char *dptr = (unsigned char *)dbuf;
+size_t j;
+
+switch (size) {
+    case 2:                                             /* four at a time, then the rest */
+        for (j = 0; j + 4 <= count; j += 4, sptr += 8, dptr += 8) {
+            const t_uint64 m = ((t_uint64)0x00FF00FF << 32) | 0x00FF00FF;
+            t_uint64 v;
+
+            memcpy (&v, sptr, sizeof (v));
+            v = ((v & m) << 8) | ((v >> 8) & m);
+            memcpy (dptr, &v, sizeof (v));
+            }
+        for (; j < count; j++, sptr += 2, dptr += 2) {
+            uint16 v;
+
+            memcpy (&v, sptr, sizeof (v));
+            v = SWAP16 (v);
+            memcpy (dptr, &v, sizeof (v));
+            }
+        break;
+    case 4:
+        for (j = 0; j < count; j++, sptr += 4, dptr += 4) {
+            uint32 v;
+
+            memcpy (&v, sptr, sizeof (v));
+            v = SWAP32 (v);
+            memcpy (dptr, &v, sizeof (v));
+            }
+        break;
+    case 8:
+        for (j = 0; j < count; j++, sptr += 8, dptr += 8) {
+            t_uint64 v;
+
+            memcpy (&v, sptr, sizeof (v));
+            v = SWAP64 (v);
+            memcpy (dptr, &v, sizeof (v));
+            }
+        break;
+    default:
+        if (sptr == dptr) {                             /* in place? */
+            for (j = 0; j < count; j++, dptr += size) { /* loop on items */
+                size_t lo, hi;
+
+                for (lo = 0, hi = size - 1; lo < hi; lo++, hi--) {
+                    unsigned char by = dptr[lo];        /* swap end-for-end */
+
+                    dptr[lo] = dptr[hi];
+                    dptr[hi] = by;
+                    }
+                }
+            }
+        else {
+            for (j = 0; j < count; j++, dptr += size) { /* loop on items */
+                int32 k;
+
+                for (k = (int32)(size - 1); k >= 0; k--)
+                    *(dptr + k) = *sptr++;
+                }
+            }
+        break;
+    }
+}
+
 int32 sim_finit (void)
 {
 union {int32 i; char c[sizeof (int32)]; } end_test;
@@ -108,21 +204,9 @@ return sim_end;
 
 void sim_buf_swap_data (void *bptr, size_t size, size_t count)
 {
-uint32 j;
-int32 k;
-unsigned char by, *sptr, *dptr;
-
 if (sim_end || (count == 0) || (size == sizeof (char)))
     return;
-for (j = 0, dptr = sptr = (unsigned char *) bptr;       /* loop on items */
-     j < count; j++) { 
-    for (k = (int32)(size - 1); k >= (((int32) size + 1) / 2); k--) {
-        by = *sptr;                                     /* swap end-for-end */
-        *sptr++ = *(dptr + k);
-        *(dptr + k) = by;
-        }
-    sptr = dptr = dptr + size;                          /* next item */
-    }
+_sim_buf_swap (bptr, bptr, size, count);
 }
 
 size_t sim_fread (void *bptr, size_t size, size_t count, FILE *fptr)
@@ -140,37 +224,35 @@ return c;
 
 void sim_buf_copy_swapped (void *dbuf, const void *sbuf, size_t size, size_t count)
 {
-size_t j;
-int32 k;
-const unsigned char *sptr = (const unsigned char *)sbuf;
-unsigned char *dptr = (unsigned char *)dbuf;
-
 if (sim_end || (size == sizeof (char))) {
-    memcpy (dptr, sptr, size * count);
+    memcpy (dbuf, sbuf, size * count);
     return;
     }
-for (j = 0; j < count; j++) {                           /* loop on items */
-    for (k = (int32)(size - 1); k >= 0; k--)
-        *(dptr + k) = *sptr++;
-    dptr = dptr + size;
-    }
+_sim_buf_swap (dbuf, sbuf, size, count);
 }
 
+/* The intermediate buffer lives on the stack, so concurrent writers
+   (asynchronous disk and tape I/O threads) each have their own without
+   a malloc per call.  fwrite buffers the output, so a chunk smaller
+   than FLIP_SIZE costs nothing in I/O. */
+
+#define FLIP_CHUNK      (FLIP_SIZE / 8)                 /* stack flip buf size */
+
 size_t sim_fwrite (const void *bptr, size_t size, size_t count, FILE *fptr)
 {
 size_t c, nelem, nbuf, lcnt, total;
 int32 i;
 const unsigned char *sptr;
-unsigned char *sim_flip;
+t_uint64 flip[FLIP_CHUNK / sizeof (t_uint64)];          /* aligned for any element */
+unsigned char *sim_flip = (unsigned char *)flip;
 
 if ((size == 0) || (count == 0))                        /* check arguments */
     return 0;
 if (sim_end || (size == sizeof (char)))                 /* le or byte? */
     return fwrite (bptr, size, count, fptr);            /* done */
-sim_flip = (unsigned char *)malloc(FLIP_SIZE);
-if (!sim_flip)
+if (size > sizeof (flip))                               /* element larger than buffer? */
     return 0;
-nelem = FLIP_SIZE / size;                               /* elements in buffer */
+nelem = sizeof (flip) / size;                           /* elements in buffer */
 nbuf = count / nelem;                                   /* number buffers */
 lcnt = count % nelem;                                   /* count in last buf */
 if (lcnt) nbuf = nbuf + 1;
@@ -179,19 +261,79 @@ total = 0;
 sptr = (const unsigned char *) bptr;                    /* init input ptr */
 for (i = (int32)nbuf; i > 0; i--) {                     /* loop on buffers */
     c = (i == 1)? lcnt: nelem;
-    sim_buf_copy_swapped (sim_flip, sptr, size, c);
-    sptr = sptr + size * count;
+    _sim_buf_swap (sim_flip, sptr, size, c);
+    sptr = sptr + size * c;
     c = fwrite (sim_flip, size, c, fptr);
-    if (c == 0) {
-        free(sim_flip);
+    if (c == 0)
         return total;
-        }
     total = total + c;
     }
-free(sim_flip);
 return total;
 }
 
+/* Library unit test: check the swap loops against a byte at a time
+   reference at the transfer sizes disks and tapes use, in place and
+   copying between unaligned buffers.  When timed is set (command line
+   -T -B) their throughput is reported as well.  The swap loops are
+   called directly so this is meaningful on little endian hosts too. */
+
+t_stat sim_fio_test (t_bool timed)
+{
+static const size_t xfer_sizes[] = {512, 2048, 4096, 32768, FLIP_SIZE};
+static const size_t elem_sizes[] = {2, 3, 4, 6, 8};
+unsigned char *src = (unsigned char *)malloc (FLIP_SIZE + 8);
+unsigned char *dst = (unsigned char *)malloc (FLIP_SIZE + 8);
+unsigned char *ref = (unsigned char *)malloc (FLIP_SIZE + 8);
+size_t s, x, i;
+t_stat stat = SCPE_OK;
+
+sim_printf ("\nTesting sim_fio byte swap routines\n");
+if (!src || !dst || !ref) {
+    free (src);
+    free (dst);
+    free (ref);
+    return SCPE_MEM;
+    }
+for (i = 0; i < FLIP_SIZE + 8; i++)
+    src[i] = (unsigned char)(i * 7 + 3);
+for (s = 0; s < sizeof (elem_sizes) / sizeof (elem_sizes[0]); s++) {
+    size_t size = elem_sizes[s];
+
+    for (x = 0; x < sizeof (xfer_sizes) / sizeof (xfer_sizes[0]); x++) {
+        size_t count = xfer_sizes[x] / size;
+        size_t bytes = count * size;
+        uint32 r, reps, start, msec;
+
+        for (i = 0; i < bytes; i++)                     /* reference result */
+            ref[i] = src[1 + i - (i % size) + (size - 1 - (i % size))];
+        _sim_buf_swap (dst + 1, src + 1, size, count);  /* unaligned copy */
+        if (memcmp (dst + 1, ref, bytes)) {
+            sim_printf ("  %d byte elements, %d byte transfer: copy swap mismatch\n", (int)size, (int)xfer_sizes[x]);
+            stat = SCPE_IERR;
+            }
+        memcpy (dst, src + 1, bytes);
+        _sim_buf_swap (dst, dst, size, count);          /* in place */
+        if (memcmp (dst, ref, bytes)) {
+            sim_printf ("  %d byte elements, %d byte transfer: in place swap mismatch\n", (int)size, (int)xfer_sizes[x]);
+            stat = SCPE_IERR;
+            }
+        if (!timed)
+            continue;
+        reps = (uint32)((64 << 20) / bytes);            /* 64MB of swapping */
+        start = sim_os_msec ();
+        for (r = 0; r < reps; r++)
+            _sim_buf_swap (dst, src, size, count);
+        msec = sim_os_msec () - start;
+        sim_printf ("  %d byte elements, %5d byte transfers: %5d MB/sec\n", (int)size, (int)xfer_sizes[x], 
+                    (int)(msec ? (64 * 1000) / msec : 64 * 1000));
+        }
+    }
+free (src);
+free (dst);
+free (ref);
+return stat;
+}
+
 /* Forward Declaration */
 
 t_offset sim_ftell (FILE *st);
@@ -560,6 +702,10 @@ return -1;
 #if defined (__linux__) || defined (__APPLE__)
 #include <sys/mman.h>
 
+#if defined (__GNUC__) && !defined (HAVE_GCC_SYNC_BUILTINS)
+#define HAVE_GCC_SYNC_BUILTINS 1
+#endif
+
 struct SHMEM {
     int shm_fd;
     size_t shm_size;
@@ -689,6 +835,191 @@ return FALSE;
 #endif /* defined (__linux__) || defined (__APPLE__) */
 #endif /* defined (_WIN32) */
 
+/* Simulated memory arena
+
+   Simulator main memories are allocated with sim_mem_alloc rather than
+   calloc.  Where the host allows, the memory comes straight from the
+   virtual memory system: pages are zero filled when first referenced, so
+   a large configured memory only costs what the guest actually touches,
+   and on Linux the region is aligned and marked for transparent huge
+   pages to reduce host TLB misses.  sim_mem_resize preserves the contents
+   and zeroes any added part.  On Linux it remaps rather than copies, and
+   a region which grows to huge page size is moved onto a freshly aligned
+   reservation so that it keeps its huge page alignment.  Callers pass
+   the size of the region to sim_mem_resize, sim_mem_free and
+   sim_mem_resident.  Elsewhere these fall back to the C heap. */
+
+#if defined (__linux__) || defined (__APPLE__)
+#include <sys/mman.h>
+#if !defined (MAP_ANONYMOUS) && defined (MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+#if (defined (__linux__) || defined (__APPLE__)) && defined (MAP_ANONYMOUS)
+
+#define SIM_MEM_HUGE    (2 * 1024 * 1024)               /* huge page size */
+
+static size_t _sim_mem_pages (size_t size)
+{
+size_t pgsz = (size_t)sysconf (_SC_PAGESIZE);
+
+return ((size ? size : 1) + pgsz - 1) & ~(pgsz - 1);
+}
+
+void *sim_mem_alloc (size_t size)
+{
+size_t lnt = _sim_mem_pages (size);
+size_t extra = (lnt >= SIM_MEM_HUGE)? SIM_MEM_HUGE: 0;
+char *base, *mem;
+
+base = (char *)mmap (NULL, lnt + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+if (base == (char *)MAP_FAILED)
+    return NULL;
+mem = base;
+if (extra) {                                            /* trim to huge page boundary */
+    mem = (char *)(((size_t)base + SIM_MEM_HUGE - 1) & ~((size_t)SIM_MEM_HUGE - 1));
+    if (mem != base)
+        munmap (base, mem - base);
+    if (mem + lnt != base + lnt + extra)
+        munmap (mem + lnt, (base + lnt + extra) - (mem + lnt));
+#if defined (MADV_HUGEPAGE)
+    madvise (mem, lnt, MADV_HUGEPAGE);
+#endif
+    }
+return mem;
+}
+
+void *sim_mem_resize (void *mem, size_t osize, size_t nsize)
+{
+size_t olnt = _sim_mem_pages (osize);
+size_t nlnt = _sim_mem_pages (nsize);
+void *nmem;
+
+if (mem == NULL)
+    return sim_mem_alloc (nsize);
+#if defined (__linux__) && defined (MREMAP_MAYMOVE)
+#if defined (MREMAP_FIXED)
+if ((nlnt > olnt) && (nlnt >= SIM_MEM_HUGE)) {          /* growing into huge pages? */
+    void *dst = sim_mem_alloc (nsize);                  /* aligned destination */
+
+    if (dst == NULL)
+        return NULL;
+    nmem = mremap (mem, olnt, nlnt, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+    if (nmem == MAP_FAILED) {
+        munmap (dst, nlnt);
+        return NULL;
+        }
+    }
+else
+#endif
+    nmem = mremap (mem, olnt, nlnt, MREMAP_MAYMOVE);    /* added pages are zero */
+if (nmem == MAP_FAILED)
+    return NULL;
+#if defined (MADV_HUGEPAGE)
+if (nlnt >= SIM_MEM_HUGE)
+    madvise (nmem, nlnt, MADV_HUGEPAGE);
+#endif
+#else
+nmem = sim_mem_alloc (nsize);
+if (nmem == NULL)
+    return NULL;
+memcpy (nmem, mem, (olnt < nlnt)? olnt: nlnt);
+munmap (mem, olnt);
+#endif
+if (nsize < nlnt)                                       /* clear past new end */
+    memset ((char *)nmem + nsize, 0, nlnt - nsize);     /* within last page */
+return nmem;
+}
+
+void sim_mem_free (void *mem, size_t size)
+{
+if (mem != NULL)
+    munmap (mem, _sim_mem_pages (size));
+}
+
+size_t sim_mem_resident (const void *mem, size_t size)
+{
+size_t pgsz = (size_t)sysconf (_SC_PAGESIZE);
+size_t i, npg = _sim_mem_pages (size) / pgsz, res = 0;
+#if defined (__linux__)
+typedef unsigned char MINCORE_VEC;
+#else
+typedef char MINCORE_VEC;
+#endif
+MINCORE_VEC *vec;
+
+if (mem == NULL)
+    return 0;
+vec = (MINCORE_VEC *)malloc (npg);
+if ((vec == NULL) || mincore ((void *)mem, npg * pgsz, vec)) {
+    free (vec);
+    return size;                                        /* unknown, assume all */
+    }
+for (i = 0; i < npg; i++)
+    if (vec[i] & 1)
+        res += pgsz;
+free (vec);
+return (res < size)? res: size;
+}
+
+#elif defined (_WIN32)
+
+void *sim_mem_alloc (size_t size)
+{
+return VirtualAlloc (NULL, size ? size : 1, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void *sim_mem_resize (void *mem, size_t osize, size_t nsize)
+{
+void *nmem = sim_mem_alloc (nsize);
+
+if ((nmem == NULL) || (mem == NULL))
+    return nmem;
+memcpy (nmem, mem, (osize < nsize)? osize: nsize);
+VirtualFree (mem, 0, MEM_RELEASE);
+return nmem;
+}
+
+void sim_mem_free (void *mem, size_t size)
+{
+if (mem != NULL)
+    VirtualFree (mem, 0, MEM_RELEASE);
+}
+
+size_t sim_mem_resident (const void *mem, size_t size)
+{
+return (mem == NULL)? 0: size;
+}
+
+#else /* C heap */
+
+void *sim_mem_alloc (size_t size)
+{
+return calloc (size ? size : 1, 1);
+}
+
+void *sim_mem_resize (void *mem, size_t osize, size_t nsize)
+{
+void *nmem = realloc (mem, nsize ? nsize : 1);
+
+if ((nmem != NULL) && (nsize > osize))
+    memset ((char *)nmem + osize, 0, nsize - osize);
+return nmem;
+}
+
+void sim_mem_free (void *mem, size_t size)
+{
+free (mem);
+}
+
+size_t sim_mem_resident (const void *mem, size_t size)
+{
+return (mem == NULL)? 0: size;
+}
+
+#endif
+
 #if defined(__VAX)
 /* 
  * We privide a 'basic' snprintf, which 'might' overrun a buffer, but
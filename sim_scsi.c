@@ -1465,8 +1465,11 @@ uint32 scsi_data (SCSI_BUS *bus, uint8 *data, uint32 len)
 {
 uint32 i;
 
-for (i = 0; ((i < len) && (bus->buf_t != bus->buf_b)); i++, bus->buf_t++)
-    bus->buf[bus->buf_t] = data[i];
+i = bus->buf_b - bus->buf_t;                            /* remaining in phase */
+if (i > len)
+    i = len;
+memcpy (&bus->buf[bus->buf_t], data, i);                /* move whole block */
+bus->buf_t += i;
 if (bus->buf_t == bus->buf_b) {
     bus->buf_t = 0;
     scsi_command (bus, &bus->cmd[0], bus->buf_b);
@@ -1528,8 +1531,11 @@ if (len == 0) {
     return 0;
     }
 scsi_release_req (bus);                                 /* assume done */
-for (i = 0; ((i < len) && (bus->buf_t != bus->buf_b)); i++, bus->buf_t++)
-    data[i] = bus->buf[bus->buf_t];
+i = bus->buf_b - bus->buf_t;                            /* remaining in phase */
+if (i > len)
+    i = len;
+memcpy (data, &bus->buf[bus->buf_t], i);                /* move whole block */
+bus->buf_t += i;
 if (bus->buf_t == bus->buf_b) {
     bus->buf_t = bus->buf_b = 0;
     switch (bus->phase) {
@@ -1555,6 +1561,25 @@ else
 return i;
 }
 
+/* Get the number of bytes remaining in the current data phase
+
+   Controllers use this to move a whole DATI or DATO phase with a
+   single scsi_read or scsi_write call rather than one byte at a time.
+   Returns zero for phases that are not buffered (command, message out). */
+
+uint32 scsi_pending (SCSI_BUS *bus)
+{
+switch (bus->phase) {
+    case SCSI_DATO:
+    case SCSI_DATI:
+    case SCSI_STS:
+    case SCSI_MSGI:
+        return bus->buf_b - bus->buf_t;
+    default:
+        return 0;
+        }
+}
+
 /* Get the state of the given SCSI device */
 
 uint32 scsi_state (SCSI_BUS *bus, uint32 id)
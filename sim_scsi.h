@@ -115,6 +115,7 @@ void scsi_release_atn (SCSI_BUS *bus);
 t_bool scsi_select (SCSI_BUS *bus, uint32 target);
 uint32 scsi_write (SCSI_BUS *bus, uint8 *data, uint32 len);
 uint32 scsi_read (SCSI_BUS *bus, uint8 *data, uint32 len);
+uint32 scsi_pending (SCSI_BUS *bus);
 uint32 scsi_state (SCSI_BUS *bus, uint32 id);
 void scsi_add_unit (SCSI_BUS *bus, uint32 id, UNIT *uptr);
 void scsi_set_unit (SCSI_BUS *bus, UNIT *uptr, SCSI_DEV *dev);
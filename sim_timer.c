@@ -178,6 +178,7 @@ static double sim_throt_inst_start;
 static uint32 sim_throt_sleep_time = 0;
 static int32 sim_throt_wait = 0;
 static uint32 sim_throt_delay = 3;
+static t_bool sim_throt_bench = FALSE;                 /* benchmark running, don't throttle */
 #define CLK_TPS 100
 #define CLK_INIT (sim_precalibrate_ips/CLK_TPS)
 static int32 sim_int_clk_tps;
@@ -230,6 +231,8 @@ UNIT sim_timer_units[SIM_NTIMERS+1];/* Clock assist units
 
 
 static t_bool sim_catchup_ticks = TRUE;
+static t_bool sim_timer_warp = FALSE;                   /* skip idle time */
+static double sim_timer_warped = 0.0;                   /* instructions skipped */
 #if defined (SIM_ASYNCH_CLOCKS) && !defined (SIM_ASYNCH_IO)
 #undef SIM_ASYNCH_CLOCKS
 #endif
@@ -992,6 +995,11 @@ if (!sim_signaled_int_char &&
     sim_debug (DBG_CAL, &sim_timer_dev, "sim_rtcn_calb(tmr=%d) gratuitious keyboard poll after %d msecs\n", tmr, (int)(new_rtime - sim_last_poll_kbd_time));
     (void)sim_poll_kbd ();
     }
+if (sim_timer_warp) {                               /* warping? */
+    if (rtc->calibrations == 0)                     /* never calibrated? */
+        rtc->currd = (int32)(((double)sim_precalibrate_ips) / ticksper);/* use estimated rate */
+    return rtc->currd;                              /* ticks by instruction count */
+    }
 ++rtc->calibrations;                                /* count calibrations */
 sim_debug (DBG_TRC, &sim_timer_dev, "sim_rtcn_calb(ticksper=%d, tmr=%d)\n", ticksper, tmr);
 if (new_rtime < rtc->rtime) {                       /* time running backwards? */
@@ -1209,6 +1217,8 @@ else
 #if defined(SIM_ASYNCH_CLOCKS)
 fprintf (st, "Asynchronous Clocks:            %s\n", sim_asynch_timer ? "Active" : "Available");
 #endif
+if (sim_timer_warp)
+    fprintf (st, "Time Warp:                      Enabled, %s instructions skipped\n", sim_fmt_numeric (sim_timer_warped));
 if (sim_time_at_sim_prompt != 0.0) {
     double prompt_time = 0.0;
     if (!sim_is_running)
@@ -1438,6 +1448,44 @@ fprintf (st, "Calibrated Ticks%s", sim_catchup_ticks ? " with Catchup Ticks" : "
 return SCPE_OK;
 }
 
+/* Set/Clear time warp
+
+   While warping, idle time is skipped rather than slept through and the
+   calibrated clocks tick on instruction count alone.  When warping stops,
+   the calibration and catchup state is resynchronized with wall time.
+*/
+
+t_stat sim_timer_set_warp (int32 flag, CONST char *cptr)
+{
+int32 tmr;
+
+if (flag) {
+#if defined (SIM_ASYNCH_CLOCKS)
+    if (sim_asynch_timer)
+        return sim_messagef (SCPE_ARG, "Time Warp is not available with asynchronous clocks\n");
+#endif
+    sim_timer_warp = TRUE;
+    }
+else {
+    if (sim_timer_warp) {
+        sim_timer_warp = FALSE;
+        for (tmr=0; tmr<=SIM_NTIMERS; tmr++) {
+            RTC *rtc = &rtcs[tmr];
+
+            rtc->rtime = sim_os_msec ();
+            rtc->vtime = rtc->rtime;
+            rtc->nxintv = 1000;
+            rtc->gtime = sim_gtime ();
+            rtc->based = rtc->currd;
+            rtc->clock_time_idled_last = rtc->clock_time_idled;
+            if (rtc->clock_catchup_eligible)
+                rtc->clock_catchup_base_time = sim_timenow_double () - rtc->calib_tick_time;
+            }
+        }
+    }
+return SCPE_OK;
+}
+
 /* Set idle calibration threshold */
 
 t_stat sim_timer_set_idle_pct (int32 flag, CONST char *cptr)
@@ -1493,6 +1541,8 @@ return SCPE_OK;
 t_stat sim_timer_set_async (int32 flag, CONST char *cptr)
 {
 if (flag) {
+    if (sim_timer_warp)
+        return sim_messagef (SCPE_ARG, "Asynchronous clocks are not available with Time Warp\n");
     if (sim_asynch_enabled && (!sim_asynch_timer)) {
         sim_asynch_timer = TRUE;
         sim_timer_change_asynch ();
@@ -1515,6 +1565,8 @@ static CTAB set_timer_tab[] = {
     { "CATCHUP",    &sim_timer_set_catchup,  1 },
     { "NOCATCHUP",  &sim_timer_set_catchup,  0 },
     { "CALIB",      &sim_timer_set_idle_pct, 0 },
+    { "WARP",       &sim_timer_set_warp,     1 },
+    { "NOWARP",     &sim_timer_set_warp,     0 },
     { "STOP",       &sim_timer_set_stop, 0 },
     { NULL, NULL, 0 }
     };
@@ -1637,7 +1689,8 @@ if ((!sim_idle_enab)                             ||     /* idling disabled */
      (!sim_asynch_timer))||                             /*     and not asynch? */
     ((sim_clock_queue != QUEUE_LIST_END) &&             /* or clock queue not empty */
      ((sim_clock_queue->flags & UNIT_IDLE) == 0))||     /*   and event not idle-able? */
-    (rtc->elapsed < sim_idle_stable)) {             /* or calibrated timer not stable? */
+    ((rtc->elapsed < sim_idle_stable) &&                /* or calibrated timer not stable */
+     (!sim_timer_warp))) {                              /*   and not warping? */
     sim_debug (DBG_IDL, &sim_timer_dev, "Can't idle: %s - elapsed: %d.%03d\n", !sim_idle_enab ? "idle disabled" : 
                                                                              ((rtc->elapsed < sim_idle_stable) ? "not stable" : 
                                                                                                                      ((sim_clock_queue != QUEUE_LIST_END) ? sim_uname (sim_clock_queue) : 
@@ -1669,6 +1722,18 @@ if ((!sim_idle_enab)                             ||     /* idling disabled */
    means something, while not idling when it isn't enabled.  
    */
 sim_debug (DBG_TRC, &sim_timer_dev, "sim_idle(tmr=%d, sin_cyc=%d)\n", tmr, sin_cyc);
+if (sim_timer_warp) {                                   /* time warp? */
+    if (sim_clock_queue == QUEUE_LIST_END)
+        sim_debug (DBG_IDL, &sim_timer_dev, "warping %d instructions\n", sim_interval);
+    else
+        sim_debug (DBG_IDL, &sim_timer_dev, "warping %d instructions to event on %s\n", sim_interval, sim_uname(sim_clock_queue));
+    if (sim_interval > 0) {
+        sim_timer_warped += sim_interval;
+        sim_interval = 0;                               /* next event is due now */
+        }
+    sim_idle_end_time = sim_gtime();                    /* save idle completed time */
+    return TRUE;
+    }
 if (sim_idle_cyc_ms == 0) {
     sim_idle_cyc_ms = (rtc->currd * rtc->hz) / 1000;/* cycles per msec */
     if (sim_idle_rate_ms != 0)
@@ -1877,7 +1942,8 @@ return SCPE_OK;
 
 void sim_throt_sched (void)
 {
-if (sim_throt_type != SIM_THROT_NONE) {
+if ((sim_throt_type != SIM_THROT_NONE) &&
+    (!sim_throt_bench)) {
     if (sim_throt_state == SIM_THROT_STATE_THROTTLE) {  /* Previously calibrated? */
         /* Reset recalibration reference times */
         sim_throt_ms_start = sim_os_msec ();
@@ -1898,6 +1964,29 @@ void sim_throt_cancel (void)
 sim_cancel (&sim_throttle_unit);
 }
 
+/* Benchmark mode
+
+   While the BENCHMARK command is executing the simulator must run at full
+   host speed, so throttling is not scheduled and idling is disabled.  The
+   throttle settings are left untouched and the idle setting is restored
+   when benchmark mode ends.
+*/
+
+void sim_timer_set_benchmark (t_bool enable)
+{
+static t_bool saved_idle_enab = FALSE;
+
+if (enable == sim_throt_bench)
+    return;
+sim_throt_bench = enable;
+if (enable) {
+    saved_idle_enab = sim_idle_enab;
+    sim_idle_enab = FALSE;
+    }
+else
+    sim_idle_enab = saved_idle_enab;
+}
+
 /* Throttle service
 
    Throttle service has three distinct states used while dynamically
@@ -2224,6 +2313,8 @@ t_bool bReturn = FALSE;
 
 if (!sim_catchup_ticks)
     return FALSE;
+if (sim_timer_warp)                                     /* no wall clock to catch up to */
+    return FALSE;
 if (time == -1) {
     for (tmr=0; tmr<=SIM_NTIMERS; tmr++) {
         rtc = &rtcs[tmr];
@@ -50,6 +50,31 @@
 #define pthread_mutex_t int
 #endif
 
+#if !defined(_WIN32)
+#include <poll.h>
+#endif
+
+/* Transmit requests are handed from the simulator to the NAT thread
+   through a single producer/single consumer ring.  The sender fills
+   the slot at write_tail and then advances it; the NAT thread drains
+   from write_head.  Neither side takes a lock on the packet path,
+   only a memory barrier to publish the slot contents before the index.
+   There is one sender per NAT device: either the simulator thread or,
+   with asynchronous I/O, the Ethernet writer thread. */
+
+#if defined(__GNUC__)
+#define SLIRP_BARRIER(slirp) __sync_synchronize ()
+#elif defined(_WIN32)
+#define SLIRP_BARRIER(slirp) MemoryBarrier ()
+#else
+#define SLIRP_BARRIER(slirp) do {                           \
+    pthread_mutex_lock (&(slirp)->write_buffer_lock);       \
+    pthread_mutex_unlock (&(slirp)->write_buffer_lock);     \
+    } while (0)
+#endif
+
+#define SLIRP_WRITE_RING 256            /* transmit ring size (power of 2) */
+
 #define IS_TCP 0
 #define IS_UDP 1
 static const char *tcpudp[] = {
@@ -132,7 +157,6 @@ return ret;
 }
 
 struct slirp_write_request {
-    struct slirp_write_request *next;
     char msg[1518];
     size_t len;
     };
@@ -154,9 +178,11 @@ struct sim_slirp {
     struct redir_tcp_udp *rtcp;
     GArray *gpollfds;
     SOCKET db_chime;            /* write packet doorbell */
-    struct slirp_write_request *write_requests;
-    struct slirp_write_request *write_buffers;
-    pthread_mutex_t write_buffer_lock;
+    struct slirp_write_request *write_ring; /* transmit request ring */
+    volatile uint32 write_head;         /* next request to deliver (NAT thread) */
+    volatile uint32 write_tail;         /* next free slot (sender) */
+    uint32 write_drops;                 /* requests dropped on a full ring */
+    pthread_mutex_t write_buffer_lock;  /* barrier for hosts without one */
     void *opaque;               /* opaque value passed during packet delivery */
     packet_callback callback;   /* slirp arriving packet delivery callback */
     DEVICE *dptr;
@@ -190,6 +216,7 @@ slirp->callback = callback;
 slirp->maskbits = 24;
 slirp->dhcpmgmt = 1;
 slirp->db_chime = INVALID_SOCKET;
+slirp->write_ring = (struct slirp_write_request *)g_malloc0 (SLIRP_WRITE_RING * sizeof (*slirp->write_ring));
 inet_aton(DEFAULT_IP_ADDR,&slirp->vgateway);
 pthread_mutex_init (&slirp->write_buffer_lock, NULL);
 
@@ -381,18 +408,7 @@ if (slirp) {
     g_array_free(slirp->gpollfds, true);
     if (slirp->db_chime != INVALID_SOCKET)
         closesocket (slirp->db_chime);
-    if (1) {
-        struct slirp_write_request *buffer;
-
-        while (NULL != (buffer = slirp->write_buffers)) {
-            slirp->write_buffers = buffer->next;
-            free(buffer);
-            }
-        while (NULL != (buffer = slirp->write_requests)) {
-            slirp->write_requests = buffer->next;
-            free(buffer);
-            }
-        }
+    g_free (slirp->write_ring);
     pthread_mutex_destroy (&slirp->write_buffer_lock);
     if (slirp->slirp)
         slirp_cleanup(slirp->slirp);
@@ -454,43 +470,37 @@ return SCPE_OK;
 int sim_slirp_send (SLIRP *slirp, const char *msg, size_t len, int flags)
 {
 struct slirp_write_request *request;
-int wake_needed = 0;
+uint32 head, tail;
 
 if (!slirp) {
     errno = EBADF;
     return 0;
     }
-/* Get a buffer */
-pthread_mutex_lock (&slirp->write_buffer_lock);
-if (NULL != (request = slirp->write_buffers))
-    slirp->write_buffers = request->next;
-pthread_mutex_unlock (&slirp->write_buffer_lock);
-if (NULL == request)
-    request = (struct slirp_write_request *)g_malloc(sizeof(*request));
-
-/* Copy buffer contents */
+tail = slirp->write_tail;
+head = slirp->write_head;
+if ((tail - head) >= SLIRP_WRITE_RING) {    /* NAT thread fallen behind? */
+    ++slirp->write_drops;
+    sim_debug (slirp->dbit, slirp->dptr, "Transmit ring full, packet dropped\n");
+    return len;                             /* like a collision, the guest retries */
+    }
+if (len > sizeof (request->msg))
+    len = sizeof (request->msg);
+
+/* Copy buffer contents into the next free slot */
+request = &slirp->write_ring[tail & (SLIRP_WRITE_RING - 1)];
 request->len = len;
 memcpy(request->msg, msg, len);
 
-/* Insert buffer at the end of the write list (to make sure that */
-/* packets make it to the wire in the order they were presented here) */
-pthread_mutex_lock (&slirp->write_buffer_lock);
-request->next = NULL;
-if (slirp->write_requests) {
-    struct slirp_write_request *last_request = slirp->write_requests;
+/* Publish the slot (requests are delivered in the order presented here) */
+SLIRP_BARRIER (slirp);
+slirp->write_tail = tail + 1;
 
-    while (last_request->next) {
-        last_request = last_request->next;
-        }
-    last_request->next = request;
-    }
-else {
-    slirp->write_requests = request;
-    wake_needed = 1;
-    }
-pthread_mutex_unlock (&slirp->write_buffer_lock);
-
-if (wake_needed)
+/* Ring the doorbell if the NAT thread had drained everything ahead of this
+   request.  head is re-read after tail is published: if it is still short
+   of tail, the NAT thread has yet to advance past an earlier request and
+   will see this one when it rechecks write_tail. */
+SLIRP_BARRIER (slirp);
+if (slirp->write_head == tail)
     sim_write_sock (slirp->db_chime, msg, 0);
 return len;
 }
@@ -534,9 +544,12 @@ while (rtmp) {
     fprintf (st, "        redir %3s     =%d:%s:%d\n", tcpudp[rtmp->is_udp], rtmp->lport, inet_ntoa(rtmp->inaddr), rtmp->port);
     rtmp = rtmp->next;
     }
+if (slirp->write_drops)
+    fprintf (st, "        transmit drops=%u\n", slirp->write_drops);
 slirp_connection_info (slirp->slirp, (Monitor *)st);
 }
 
+#if defined(_WIN32)
 #if !defined(MAX)
 #define MAX(a,b) (((a)>(b)) ? (a) : (b))
 #endif
@@ -589,21 +602,47 @@ for (i = 0; i < pollfds->len; i++) {
     pfd->revents = revents & pfd->events;
     }
 }
+#endif /* _WIN32 */
 
 int sim_slirp_select (SLIRP *slirp, int ms_timeout)
 {
 int select_ret = 0;
 uint32 slirp_timeout = ms_timeout;
+#if defined(_WIN32)
 struct timeval timeout;
 fd_set rfds, wfds, xfds;
 fd_set save_rfds, save_wfds, save_xfds;
 int nfds;
+#else
+guint i;
+#endif
 
 if (!slirp)                         /* Not active? */
     return -1;                      /* That's an error */
 /* Populate the GPollFDs from slirp */
 g_array_set_size (slirp->gpollfds, 1);  /* Leave the doorbell chime alone */
 slirp_pollfds_fill(slirp->gpollfds, &slirp_timeout);
+#if !defined(_WIN32)
+/* GPollFD has the same layout and event bits as struct pollfd, so the
+   array slirp just filled is handed straight to poll() rather than
+   being translated into fd_sets and back on every pass */
+select_ret = poll ((struct pollfd *)slirp->gpollfds->data, slirp->gpollfds->len, (int)slirp_timeout);
+if (select_ret > 0) {
+    GPollFD *pfd = &g_array_index(slirp->gpollfds, GPollFD, 0);
+
+    if (pfd->revents & G_IO_IN) {
+        char buf[32];
+        /* consume the doorbell wakeup ring */
+        (void)recv (slirp->db_chime, buf, sizeof (buf), 0);
+        }
+    sim_debug (slirp->dbit, slirp->dptr, "Poll returned %d\r\n", select_ret);
+    for (i = 0; i < slirp->gpollfds->len; i++) {
+        pfd = &g_array_index(slirp->gpollfds, GPollFD, i);
+        if (pfd->revents)
+            sim_debug (slirp->dbit, slirp->dptr, "%d: events=%X, revents=%X\r\n", pfd->fd, pfd->events, pfd->revents);
+        }
+    }
+#else
 timeout.tv_sec  = slirp_timeout / 1000;
 timeout.tv_usec = (slirp_timeout % 1000) * 1000;
 
@@ -635,6 +674,7 @@ if (select_ret) {
             sim_debug (slirp->dbit, slirp->dptr, "%d: save_xfd=%d, xfd=%d\r\n", i, FD_ISSET(i, &save_xfds), FD_ISSET(i, &xfds));
             }
     }
+#endif
 return select_ret + 1;  /* Force dispatch even on timeout */
 }
 
@@ -644,20 +684,16 @@ struct slirp_write_request *request;
 
 /* first deliver any transmit packets which are pending */
 
-pthread_mutex_lock (&slirp->write_buffer_lock);
-while (NULL != (request = slirp->write_requests)) {
-    /* Pull buffer off request list */
-    slirp->write_requests = request->next;
-    pthread_mutex_unlock (&slirp->write_buffer_lock);
+while (slirp->write_head != slirp->write_tail) {
+    SLIRP_BARRIER (slirp);                  /* see the slot contents */
+    request = &slirp->write_ring[slirp->write_head & (SLIRP_WRITE_RING - 1)];
 
     slirp_input (slirp->slirp, (const uint8_t *)request->msg, (int)request->len);
 
-    pthread_mutex_lock (&slirp->write_buffer_lock);
-    /* Put buffer on free buffer list */
-    request->next = slirp->write_buffers;
-    slirp->write_buffers = request;
+    SLIRP_BARRIER (slirp);                  /* done with the slot */
+    slirp->write_head = slirp->write_head + 1;
+    SLIRP_BARRIER (slirp);                  /* publish head before rechecking tail */
     }
-pthread_mutex_unlock (&slirp->write_buffer_lock);
 
 slirp_pollfds_poll(slirp->gpollfds, 0);
 